@@ -0,0 +1,275 @@
+///////////////////////////////////////////////////////////////////////////////
+// CommandQueue.h
+//
+// Bounded multi-producer single-consumer queue of typed commands
+//
+// Input sources other than the serial console (e.g. a second UART, a network
+// socket, a timer) enqueue commands from any task or interrupt; loop() is the
+// single consumer and applies the commands between transmissions.
+//
+// - Targets with compare-and-swap (ESP32, host): lock-free - each cell has a
+//   sequence number; producers claim a cell by CAS on the tail index and
+//   publish it by storing the sequence number. A full queue is reported to
+//   the producer, which never waits for the consumer.
+// - Targets without compare-and-swap (ESP8266, RP2040/Cortex-M0+): the
+//   index updates are done with interrupts disabled for a few instructions
+//   (critical section on ESP32 variants without compare-and-swap).
+//
+// JSON updates carry a string which is allocated by the producer and deleted
+// by the consumer - they cannot be enqueued from interrupts. All other
+// commands can.
+//
+// Does not depend on the Arduino core (usable on the host).
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef COMMAND_QUEUE_H
+#define COMMAND_QUEUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <new>
+
+#if (__GCC_ATOMIC_INT_LOCK_FREE == 2) || !defined(ARDUINO)
+    #define COMMAND_QUEUE_LOCK_FREE 1
+    #include <atomic>
+#elif defined(ESP8266)
+    #include <interrupts.h>
+    //! Interrupts disabled in scope
+    typedef esp8266::InterruptLock CommandQueueLock;
+#elif defined(ARDUINO_ARCH_RP2040)
+    #include <hardware/sync.h>
+    //! Interrupts disabled in scope
+    struct CommandQueueLock {
+        CommandQueueLock() : _state(save_and_disable_interrupts()) {}
+        ~CommandQueueLock() { restore_interrupts(_state); }
+        uint32_t _state;
+    };
+#elif defined(ESP32)
+    //! Critical section in scope (task or interrupt)
+    struct CommandQueueLock {
+        CommandQueueLock() { portENTER_CRITICAL_SAFE(&mux()); }
+        ~CommandQueueLock() { portEXIT_CRITICAL_SAFE(&mux()); }
+        static portMUX_TYPE &mux()
+        {
+            static portMUX_TYPE m = portMUX_INITIALIZER_UNLOCKED;
+            return m;
+        }
+    };
+#else
+    //! Interrupts disabled in scope - producers must not be interrupts
+    struct CommandQueueLock {
+        CommandQueueLock() { noInterrupts(); }
+        ~CommandQueueLock() { interrupts(); }
+    };
+#endif
+
+#if defined(ARDUINO)
+    #define COMMAND_QUEUE_ALIGN
+#else
+    // Tail (producers) and head (consumer) in separate cache lines
+    #define COMMAND_QUEUE_ALIGN alignas(64)
+#endif
+
+//! Command type
+enum class CommandType : uint8_t {
+    JSON,       //!< JSON update (single sensor or batch), json: string
+    ENCODER,    //!< select encoder, arg: Encoders
+    INTERVAL,   //!< set transmit interval, value: seconds
+    STATS       //!< print statistics, arg: StatsFormat
+};
+
+//! Command
+struct Command {
+    CommandType type;   //!< command type
+    uint8_t arg;        //!< ENCODER: Encoders, STATS: StatsFormat
+    uint32_t value;     //!< INTERVAL: transmit interval in s
+    char *json;         //!< JSON: string allocated with new[], deleted by consumer
+
+    //! JSON update - copies the string (not from interrupts); json is nullptr if out of memory
+    static Command jsonUpdate(const char *str)
+    {
+        size_t len = strlen(str);
+        Command c = {CommandType::JSON, 0, 0, new (std::nothrow) char[len + 1]};
+        if (c.json)
+        {
+            memcpy(c.json, str, len + 1);
+        }
+        return c;
+    }
+
+    static Command encoder(uint8_t id)
+    {
+        return {CommandType::ENCODER, id, 0, nullptr};
+    }
+
+    static Command interval(uint32_t seconds)
+    {
+        return {CommandType::INTERVAL, 0, seconds, nullptr};
+    }
+
+    static Command stats(uint8_t format)
+    {
+        return {CommandType::STATS, format, 0, nullptr};
+    }
+};
+
+/*!
+ * \brief Bounded MPSC queue
+ *
+ * \tparam T    item type (copyable)
+ * \tparam N    number of cells (power of 2)
+ */
+template <typename T, size_t N>
+class MpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of 2");
+
+public:
+    MpscQueue() : _tail(0), _head(0), _dropped(0)
+    {
+#if defined(COMMAND_QUEUE_LOCK_FREE)
+        for (uint32_t i = 0; i < N; i++)
+        {
+            _seq[i].store(i, std::memory_order_relaxed);
+        }
+#endif
+    }
+
+    /*!
+     * \brief Enqueue item - any task or interrupt
+     *
+     * \returns false if the queue is full
+     */
+    bool push(const T &item)
+    {
+#if defined(COMMAND_QUEUE_LOCK_FREE)
+        uint32_t pos = _tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            int32_t diff = (int32_t)(_seq[pos & (N - 1)].load(std::memory_order_acquire) - pos);
+            if (diff == 0)
+            {
+                // Cell is free - claim it
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // Cell still holds an item one round behind
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                // Cell claimed by another producer
+                pos = _tail.load(std::memory_order_relaxed);
+            }
+        }
+        _item[pos & (N - 1)] = item;
+        _seq[pos & (N - 1)].store(pos + 1, std::memory_order_release);
+        return true;
+#else
+        CommandQueueLock lock;
+        if (_tail - _head == N)
+        {
+            _dropped++;
+            return false;
+        }
+        _item[_tail & (N - 1)] = item;
+        _tail++;
+        return true;
+#endif
+    }
+
+    /*!
+     * \brief Dequeue item - consumer only
+     *
+     * \returns false if the queue is empty (or the next item is not published yet)
+     */
+    bool pop(T &item)
+    {
+#if defined(COMMAND_QUEUE_LOCK_FREE)
+        uint32_t pos = _head;
+        if (_seq[pos & (N - 1)].load(std::memory_order_acquire) != pos + 1)
+        {
+            return false;
+        }
+        item = _item[pos & (N - 1)];
+        _seq[pos & (N - 1)].store(pos + N, std::memory_order_release);
+        _head = pos + 1;
+        return true;
+#else
+        CommandQueueLock lock;
+        if (_head == _tail)
+        {
+            return false;
+        }
+        item = _item[_head & (N - 1)];
+        _head++;
+        return true;
+#endif
+    }
+
+    //! Number of items rejected because the queue was full
+    uint32_t dropped(void) const
+    {
+#if defined(COMMAND_QUEUE_LOCK_FREE)
+        return _dropped.load(std::memory_order_relaxed);
+#else
+        return _dropped;
+#endif
+    }
+
+private:
+    T _item[N];
+#if defined(COMMAND_QUEUE_LOCK_FREE)
+    std::atomic<uint32_t> _seq[N];  //!< pos + 1: published, pos + N: free for next round
+    COMMAND_QUEUE_ALIGN std::atomic<uint32_t> _tail;
+    COMMAND_QUEUE_ALIGN uint32_t _head;
+    std::atomic<uint32_t> _dropped;
+#else
+    volatile uint32_t _tail;
+    volatile uint32_t _head;
+    volatile uint32_t _dropped;
+#endif
+};
+
+#endif // COMMAND_QUEUE_H
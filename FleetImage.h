@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////
+// FleetImage.h
+//
+// Persistent fleet configuration - binary image of the emulated sensors
+//
+// The image is a plain structure which is written to and read from flash
+// (or a file on the host) as it is - loading takes a single read and a CRC
+// check, no parsing. Only the used part of the JSON string is stored.
+//
+// The header contains a version and the size of the sensor data record; an
+// image written by a firmware with a different layout is rejected. Increment
+// FLEET_IMAGE_VERSION if the layout of FleetImage is changed.
+//
+// Does not depend on the Arduino core (usable on the host).
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          FLEET_IMAGE_VERSION 2: sensor data as SensorRecord (scaled integers)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef FLEET_IMAGE_H
+#define FLEET_IMAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define FLEET_IMAGE_MAGIC   0x49465453UL    //!< "STFI" (little endian)
+#define FLEET_IMAGE_VERSION 2               //!< image layout version
+
+/*!
+ * \brief CRC-32 (IEEE 802.3, reflected)
+ *
+ * Table driven with 4 bits per step - 64 bytes of table.
+ *
+ * \param data  data
+ * \param len   length of data in bytes
+ *
+ * \returns CRC-32
+ */
+inline uint32_t crc32(const uint8_t *data, size_t len)
+{
+    static const uint32_t table[16] = {
+        0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+        0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+        0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+        0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+    };
+    uint32_t crc = 0xFFFFFFFFUL;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+/*!
+ * \brief Fleet configuration image
+ *
+ * \tparam S    sensor data record
+ * \tparam N    max. number of emulated sensors
+ * \tparam J    max. size of JSON string (incl. terminating null character)
+ */
+template <typename S, size_t N, size_t J>
+struct FleetImage {
+    //! Header - checked before any other member is used
+    struct Header {
+        uint32_t magic;         //!< FLEET_IMAGE_MAGIC
+        uint16_t version;       //!< FLEET_IMAGE_VERSION
+        uint16_t record_size;   //!< sizeof(S)
+        uint32_t size;          //!< image size in bytes (incl. header)
+        uint32_t crc;           //!< CRC-32 of image without header
+    };
+
+    //! Emulated sensor
+    struct Slot {
+        S sensor;               //!< sensor data (own data only)
+        uint16_t traffic_param; //!< traffic model parameter
+        uint8_t traffic;        //!< arrival process (Traffic)
+        uint8_t encoder;        //!< encoder (own data only)
+        uint8_t own_data;       //!< sensor data from batch update or 'set'
+    };
+
+    Header hdr;
+    uint32_t tx_interval;       //!< transmit interval in seconds
+    uint32_t traffic_seed;      //!< seed for traffic model PRNG
+    uint8_t encoder;            //!< selected encoder (Encoders)
+    uint8_t fleet_size;         //!< number of emulated sensors
+    uint8_t tx_on_input;        //!< transmit on arrival of JSON data
+    Slot slot[N];               //!< emulated sensors
+    S json_sensor;              //!< sensor data from JSON string
+    uint16_t json_len;          //!< length of JSON string
+    char json[J];               //!< JSON string (only json_len bytes are stored)
+
+    //! Size of image without JSON string
+    size_t fixedSize(void) const
+    {
+        return reinterpret_cast<const uint8_t *>(json) - reinterpret_cast<const uint8_t *>(this);
+    }
+
+    /*!
+     * \brief Copy JSON string and complete header
+     *
+     * \param str   JSON string
+     * \param len   length of JSON string (truncated to J - 1)
+     *
+     * \returns image size in bytes
+     */
+    size_t seal(const char *str, size_t len)
+    {
+        json_len = (len < J) ? len : J - 1;
+        memcpy(json, str, json_len);
+        hdr.magic = FLEET_IMAGE_MAGIC;
+        hdr.version = FLEET_IMAGE_VERSION;
+        hdr.record_size = sizeof(S);
+        hdr.size = fixedSize() + json_len;
+        hdr.crc = crc32(reinterpret_cast<const uint8_t *>(this) + sizeof(Header), hdr.size - sizeof(Header));
+        return hdr.size;
+    }
+
+    /*!
+     * \brief Check image after reading
+     *
+     * Terminates the JSON string if the image is valid.
+     *
+     * \param len   number of bytes read
+     *
+     * \returns true if the image is complete, has the expected layout and the CRC matches
+     */
+    bool check(size_t len)
+    {
+        if (len < sizeof(Header) ||
+            hdr.magic != FLEET_IMAGE_MAGIC || hdr.version != FLEET_IMAGE_VERSION ||
+            hdr.record_size != sizeof(S) || hdr.size != len ||
+            len < fixedSize() || json_len >= J || hdr.size != fixedSize() + json_len)
+        {
+            return false;
+        }
+        if (crc32(reinterpret_cast<const uint8_t *>(this) + sizeof(Header), hdr.size - sizeof(Header)) != hdr.crc)
+        {
+            return false;
+        }
+        json[json_len] = '\0';
+        return true;
+    }
+};
+
+#endif // FLEET_IMAGE_H
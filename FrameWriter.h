@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////
+// FrameWriter.h
+//
+// Bounded writer for radio message frames
+//
+// The preamble, sync word and payload encoders write directly into the
+// message buffer - no intermediate payload arrays and copies are needed.
+// Bounds checking is only done in debug builds (CORE_DEBUG_LEVEL >= DEBUG).
+//
+// Does not depend on the Arduino core (usable on the host).
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added write_P()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef FRAME_WRITER_H
+#define FRAME_WRITER_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(ARDUINO)
+    #include <Arduino.h>
+    #include "logging.h"
+#elif !defined(memcpy_P)
+    #define memcpy_P memcpy
+#endif
+
+#if defined(CORE_DEBUG_LEVEL) && defined(ARDUHAL_LOG_LEVEL_DEBUG)
+    #if CORE_DEBUG_LEVEL >= ARDUHAL_LOG_LEVEL_DEBUG
+        #define FRAME_WRITER_CHECK_BOUNDS
+    #endif
+#endif
+
+/*!
+ * \brief Bounded writer for a message frame buffer
+ *
+ * The writer does not own the buffer. All write operations append at
+ * the current position; reserve() returns a pointer to a zeroed region
+ * which can be filled in arbitrary order by the payload encoders.
+ */
+class FrameWriter {
+public:
+    /*!
+     * \brief Constructor
+     *
+     * \param buf       message buffer
+     * \param capacity  size of message buffer in bytes
+     */
+    FrameWriter(uint8_t *buf, size_t capacity) : _buf(buf), _capacity(capacity), _size(0)
+    {
+    }
+
+    /*!
+     * \brief Append a single byte
+     */
+    inline void put(uint8_t b)
+    {
+        check(1);
+        _buf[_size++] = b;
+    }
+
+    /*!
+     * \brief Append n copies of a byte (e.g. preamble)
+     */
+    inline void fill(uint8_t b, size_t n)
+    {
+        check(n);
+        memset(&_buf[_size], b, n);
+        _size += n;
+    }
+
+    /*!
+     * \brief Append n bytes from src
+     */
+    inline void write(const uint8_t *src, size_t n)
+    {
+        check(n);
+        memcpy(&_buf[_size], src, n);
+        _size += n;
+    }
+
+    /*!
+     * \brief Append n bytes from src in flash memory (PROGMEM)
+     */
+    inline void write_P(const uint8_t *src, size_t n)
+    {
+        check(n);
+        memcpy_P(&_buf[_size], src, n);
+        _size += n;
+    }
+
+    /*!
+     * \brief Reserve n bytes at the current position
+     *
+     * \returns pointer to n zero-initialized bytes in the message buffer
+     */
+    inline uint8_t *reserve(size_t n)
+    {
+        check(n);
+        uint8_t *p = &_buf[_size];
+        memset(p, 0, n);
+        _size += n;
+        return p;
+    }
+
+    /*!
+     * \brief Discard all data
+     */
+    inline void clear(void)
+    {
+        _size = 0;
+    }
+
+    /*!
+     * \brief Start of message buffer
+     */
+    inline uint8_t *data(void) const
+    {
+        return _buf;
+    }
+
+    /*!
+     * \brief Number of bytes written
+     */
+    inline size_t size(void) const
+    {
+        return _size;
+    }
+
+    /*!
+     * \brief Size of message buffer
+     */
+    inline size_t capacity(void) const
+    {
+        return _capacity;
+    }
+
+private:
+    uint8_t *_buf;
+    size_t _capacity;
+    size_t _size;
+
+    inline void check(size_t n) const
+    {
+#if defined(FRAME_WRITER_CHECK_BOUNDS)
+        if (_size + n > _capacity)
+        {
+            log_e("Frame buffer overflow (%u + %u > %u)!", (unsigned)_size, (unsigned)n, (unsigned)_capacity);
+            abort();
+        }
+#else
+        (void)n;
+#endif
+    }
+};
+
+#endif // FRAME_WRITER_H
@@ -0,0 +1,276 @@
+///////////////////////////////////////////////////////////////////////////////
+// JsonFilter.h
+//
+// JSON keys consumed by deSerialize() per encoder and sensor type
+//
+// The keys are used to build an ArduinoJson filter document, so only these
+// keys are stored when deserializing the input. Other keys (e.g. time, model,
+// RSSI from receiver output) are skipped by the parser.
+//
+// Batch updates (one JSON line with the data of several sensors) are either
+// an array of sensor objects or an object with the sensor IDs as keys:
+//   [{"sensor_id":1,"s_type":1,...},{"sensor_id":2,"encoder":"bresser-7in1",...}]
+//   {"1":{"s_type":1,...},"2":{"encoder":"bresser-7in1",...}}
+//
+// Does not depend on the Arduino core or on ArduinoJson (usable on the host).
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added batch update forms and key "encoder"
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef JSON_FILTER_H
+#define JSON_FILTER_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "PayloadEncoders.h"
+
+//! JSON keys - bit index in key mask
+enum JsonKey {
+    JK_SENSOR_ID, JK_S_TYPE, JK_CHAN, JK_STARTUP, JK_BATTERY_OK,
+    JK_TEMP_C, JK_HUMIDITY, JK_WIND_GUST, JK_WIND_AVG, JK_WIND_DIR, JK_RAIN, JK_UV, JK_LIGHT,
+    JK_MOISTURE, JK_PM_2_5, JK_PM_10, JK_CO2, JK_HCHO, JK_VOC,
+    JK_STRIKE_COUNT, JK_DISTANCE, JK_ALARM,
+    JK_ENCODER,
+    JK_NUM
+};
+
+//! JSON key names - index: JsonKey
+static const char *const json_keys[JK_NUM] = {
+    "sensor_id", "s_type", "chan", "startup", "battery_ok",
+    "temp_c", "humidity", "wind_gust_meter_sec", "wind_avg_meter_sec", "wind_direction_deg", "rain_mm", "uv", "light_klx",
+    "moisture", "pm_2_5", "pm_10", "co2_ppm", "hcho_ppb", "voc",
+    "strike_count", "distance_km", "alarm",
+    "encoder"
+};
+
+#define JK(k) (1UL << (k))
+
+//! Keys of all sensors
+#define JSON_KEYS_COMMON    (JK(JK_SENSOR_ID) | JK(JK_S_TYPE) | JK(JK_CHAN) | JK(JK_STARTUP) | JK(JK_BATTERY_OK))
+
+//! Keys of batch update entries (encoder per entry - all keys)
+#define JSON_KEYS_BATCH     (JK(JK_NUM) - 1)
+
+//! Keys of 5-in-1 weather sensor
+#define JSON_KEYS_WEATHER   (JK(JK_TEMP_C) | JK(JK_HUMIDITY) | JK(JK_WIND_GUST) | JK(JK_WIND_AVG) | JK(JK_WIND_DIR) | JK(JK_RAIN))
+
+/*!
+ * \brief Keys consumed by deSerialize()
+ *
+ * \param encoder   encoder (index: Encoders)
+ * \param s_type    sensor type (-1: not known - union of all sensor types of the encoder)
+ *
+ * \returns key mask (bit index: JsonKey)
+ */
+inline uint32_t jsonKeys(uint8_t encoder, int s_type)
+{
+    uint32_t keys = JSON_KEYS_COMMON;
+
+    switch (encoder)
+    {
+        case 0: // ENC_BRESSER_5IN1
+            keys |= JSON_KEYS_WEATHER;
+            break;
+
+        case 1: // ENC_BRESSER_6IN1
+            if (s_type == SENSOR_TYPE_SOIL || s_type < 0)
+            {
+                keys |= JK(JK_TEMP_C) | JK(JK_MOISTURE);
+            }
+            if (s_type != SENSOR_TYPE_SOIL)
+            {
+                keys |= JSON_KEYS_WEATHER | JK(JK_UV);
+            }
+            break;
+
+        case 2: // ENC_BRESSER_7IN1
+            if (s_type == SENSOR_TYPE_WEATHER1 || s_type < 0)
+            {
+                keys |= JSON_KEYS_WEATHER | JK(JK_UV) | JK(JK_LIGHT);
+            }
+            if (s_type == SENSOR_TYPE_AIR_PM || s_type < 0)
+            {
+                keys |= JK(JK_PM_2_5) | JK(JK_PM_10);
+            }
+            if (s_type == SENSOR_TYPE_CO2 || s_type < 0)
+            {
+                keys |= JK(JK_CO2);
+            }
+            if (s_type == SENSOR_TYPE_HCHO_VOC || s_type < 0)
+            {
+                keys |= JK(JK_HCHO) | JK(JK_VOC);
+            }
+            break;
+
+        case 3: // ENC_BRESSER_LEAKAGE
+            keys |= JK(JK_ALARM);
+            break;
+
+        case 4: // ENC_BRESSER_LIGHTNING
+            keys |= JK(JK_STRIKE_COUNT) | JK(JK_DISTANCE);
+            break;
+
+        default:
+            break;
+    }
+    return keys;
+}
+
+/*!
+ * \brief Get sensor type from JSON string without deserializing it
+ *
+ * Only finds the key "s_type" followed by an unsigned integer value.
+ *
+ * \param json  JSON string
+ *
+ * \returns sensor type or -1 if not found
+ */
+inline int jsonSType(const char *json)
+{
+    const char *p = strstr(json, "\"s_type\"");
+    if (!p)
+    {
+        return -1;
+    }
+    p += 8;
+    while (*p == ' ' || *p == '\t')
+    {
+        p++;
+    }
+    if (*p++ != ':')
+    {
+        return -1;
+    }
+    while (*p == ' ' || *p == '\t')
+    {
+        p++;
+    }
+    return (*p >= '0' && *p <= '9') ? atoi(p) : -1;
+}
+
+//! JSON input line forms
+enum class JsonForm : uint8_t {
+    SINGLE, //!< object with the data of one sensor
+    ARRAY,  //!< array of sensor objects
+    KEYED   //!< object with sensor objects, keys: sensor IDs
+};
+
+/*!
+ * \brief Get form of JSON input line without deserializing it
+ *
+ * An object is keyed if the value of its first member is an object.
+ *
+ * \param json  JSON string
+ *
+ * \returns form
+ */
+inline JsonForm jsonForm(const char *json)
+{
+    const char *p = json;
+    while (*p == ' ' || *p == '\t')
+    {
+        p++;
+    }
+    if (*p == '[')
+    {
+        return JsonForm::ARRAY;
+    }
+    if (*p++ != '{')
+    {
+        return JsonForm::SINGLE;
+    }
+    while (*p == ' ' || *p == '\t')
+    {
+        p++;
+    }
+    if (*p++ != '"')
+    {
+        return JsonForm::SINGLE;
+    }
+    while (*p && *p != '"')
+    {
+        if (*p++ == '\\' && *p)
+        {
+            p++;
+        }
+    }
+    if (*p++ != '"')
+    {
+        return JsonForm::SINGLE;
+    }
+    while (*p == ' ' || *p == '\t' || *p == ':')
+    {
+        p++;
+    }
+    return (*p == '{') ? JsonForm::KEYED : JsonForm::SINGLE;
+}
+
+/*!
+ * \brief Add keys to filter object
+ *
+ * \param filter    ArduinoJson filter document or object
+ * \param keys      key mask (bit index: JsonKey)
+ */
+template <typename Obj>
+void jsonFilterKeys(Obj filter, uint32_t keys)
+{
+    for (uint8_t i = 0; i < JK_NUM; i++)
+    {
+        if (keys & JK(i))
+        {
+            filter[json_keys[i]] = true;
+        }
+    }
+}
+
+/*!
+ * \brief Build filter document
+ *
+ * \param filter    ArduinoJson filter document
+ * \param keys      key mask (bit index: JsonKey)
+ */
+template <typename Doc>
+void jsonFilter(Doc &filter, uint32_t keys)
+{
+    filter.clear();
+    jsonFilterKeys<Doc &>(filter, keys);
+}
+
+#endif // JSON_FILTER_H
@@ -0,0 +1,136 @@
+///////////////////////////////////////////////////////////////////////////////
+// LineReader.h
+//
+// Non-blocking line assembler for serial console input
+//
+// Drains the available input bytes into a fixed buffer and returns each
+// complete line. Lines exceeding the buffer size are discarded.
+// In contrast to Stream::readStringUntil(), poll() never waits for the
+// Stream timeout and does not allocate memory.
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef LINE_READER_H
+#define LINE_READER_H
+
+#include <Arduino.h>
+#include "logging.h"
+
+/*!
+ * \brief Non-blocking line assembler
+ *
+ * \tparam SIZE buffer size in bytes (max. line length + 1)
+ */
+template <size_t SIZE>
+class LineReader {
+public:
+    LineReader() : _len(0), _overflow(false), _start_us(0)
+    {
+    }
+
+    /*!
+     * \brief Read available input
+     *
+     * Carriage returns are ignored. The returned line is valid until the
+     * next call of poll().
+     *
+     * \param stream input stream
+     *
+     * \returns complete line (without line terminator) or nullptr
+     */
+    const char *poll(Stream &stream)
+    {
+        while (stream.available() > 0)
+        {
+            int c = stream.read();
+            if (c < 0)
+            {
+                break;
+            }
+            if (_len == 0 && !_overflow)
+            {
+                _start_us = micros();
+            }
+            if (c == '\r')
+            {
+                continue;
+            }
+            if (c == '\n')
+            {
+                bool overflow = _overflow;
+                size_t len = _len;
+                _len = 0;
+                _overflow = false;
+                if (overflow)
+                {
+                    log_w("Line too long (max. %u characters) - discarded!", (unsigned)(SIZE - 1));
+                    continue;
+                }
+                _buf[len] = '\0';
+                return _buf;
+            }
+            if (_len < SIZE - 1)
+            {
+                _buf[_len++] = (char)c;
+            }
+            else
+            {
+                _overflow = true;
+            }
+        }
+        return nullptr;
+    }
+
+    /*!
+     * \brief Time of arrival of the first character of the last line
+     *
+     * \returns timestamp in microseconds
+     */
+    inline uint32_t lineStart(void) const
+    {
+        return _start_us;
+    }
+
+private:
+    char _buf[SIZE];
+    size_t _len;
+    bool _overflow;
+    uint32_t _start_us;
+};
+
+#endif // LINE_READER_H
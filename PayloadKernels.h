@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadKernels.h
+//
+// Word-wide helper functions for payload checksums and data transformations
+//
+// Data whitening uses 64-bit words on 64-bit hosts (the compiler may
+// vectorize the loop) and 32-bit words on the microcontrollers.
+//
+// The bit count implementation is selected at compile time:
+// - Cores with a population count instruction use __builtin_popcount()
+//   over 32-bit words (bitCountPopcount())
+// - All other cores use a nibble lookup table (bitCountNibble());
+//   __builtin_popcount() would result in a library call there
+// Both variants are available on all targets (see extras/kernel_bench).
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added whiten()
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PAYLOAD_KERNELS_H
+#define PAYLOAD_KERNELS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// x86 with POPCNT, AArch64 (CNT) and RISC-V with Zbb (CPOP)
+// Xtensa (ESP32/ESP8266) and Cortex-M0+ (RP2040) do not have such an instruction.
+#if defined(__POPCNT__) || defined(__aarch64__) || defined(__riscv_zbb)
+    #define PAYLOAD_KERNELS_HW_POPCOUNT
+#endif
+
+/*!
+ * \brief Count number of bits set in buffer - population count of 32-bit words
+ *
+ * \param buf   data
+ * \param len   data length in bytes
+ *
+ * \returns number of bits set
+ */
+inline unsigned bitCountPopcount(const uint8_t *buf, size_t len)
+{
+    unsigned count = 0;
+
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t), buf += sizeof(uint32_t))
+    {
+        uint32_t w;
+        memcpy(&w, buf, sizeof(w));
+        count += __builtin_popcount(w);
+    }
+    while (len--)
+    {
+        count += __builtin_popcount(*buf++);
+    }
+    return count;
+}
+
+/*!
+ * \brief Count number of bits set in buffer - nibble lookup table
+ *
+ * \param buf   data
+ * \param len   data length in bytes
+ *
+ * \returns number of bits set
+ */
+inline unsigned bitCountNibble(const uint8_t *buf, size_t len)
+{
+    static const uint8_t nibble_bits[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+    unsigned count = 0;
+
+    while (len--)
+    {
+        uint8_t b = *buf++;
+        count += nibble_bits[b & 0xF] + nibble_bits[b >> 4];
+    }
+    return count;
+}
+
+/*!
+ * \brief Count number of bits set in buffer
+ *
+ * \param buf   data
+ * \param len   data length in bytes
+ *
+ * \returns number of bits set
+ */
+inline unsigned bitCount(const uint8_t *buf, size_t len)
+{
+#if defined(PAYLOAD_KERNELS_HW_POPCOUNT)
+    return bitCountPopcount(buf, len);
+#else
+    return bitCountNibble(buf, len);
+#endif
+}
+
+/*!
+ * \brief Copy inverted data
+ *
+ * dst[i] = ~src[i] for i = 0...len-1; buffers must not overlap
+ *
+ * \param dst   destination
+ * \param src   source
+ * \param len   data length in bytes
+ */
+inline void invertBytes(uint8_t *dst, const uint8_t *src, size_t len)
+{
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t))
+    {
+        uint32_t w;
+        memcpy(&w, src, sizeof(w));
+        w = ~w;
+        memcpy(dst, &w, sizeof(w));
+        src += sizeof(uint32_t);
+        dst += sizeof(uint32_t);
+    }
+    while (len--)
+    {
+        *dst++ = ~*src++;
+    }
+}
+
+#if UINTPTR_MAX > 0xFFFFFFFFu
+typedef uint64_t payload_word_t;
+#else
+typedef uint32_t payload_word_t;
+#endif
+
+/*!
+ * \brief Data whitening
+ *
+ * buf[i] ^= key for i = 0...len-1
+ *
+ * \param buf   data
+ * \param len   data length in bytes
+ * \param key   whitening constant
+ */
+inline void whiten(uint8_t *buf, size_t len, uint8_t key)
+{
+    const payload_word_t k = (payload_word_t)0x0101010101010101ULL * key;
+
+    for (; len >= sizeof(payload_word_t); len -= sizeof(payload_word_t), buf += sizeof(payload_word_t))
+    {
+        payload_word_t w;
+        memcpy(&w, buf, sizeof(w));
+        w ^= k;
+        memcpy(buf, &w, sizeof(w));
+    }
+    while (len--)
+    {
+        *buf++ ^= key;
+    }
+}
+
+#endif // PAYLOAD_KERNELS_H
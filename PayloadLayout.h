@@ -0,0 +1,352 @@
+///////////////////////////////////////////////////////////////////////////////
+// PayloadLayout.h
+//
+// Declarative payload bit-field layouts
+//
+// A layout is a list of fields, each defined by
+// - the index of its value in the value array passed to pack(),
+// - position (bit offset from the MSB of payload byte 0) and width,
+// - coding (binary or BCD),
+// - flags (inverted, not covered by whitening).
+//
+// Example (Bresser 5-in-1, "GGxG" - wind gust, MSB out of sequence):
+//
+//   BinField<GUST, 8 * 16,     8>,         // byte 16: bits 7..0
+//   BinField<GUST, 8 * 17 + 4, 4, 0, 8>,   // byte 17 low nibble: bits 11..8
+//
+// All parameters are template arguments, so pack() compiles to a straight
+// sequence of shift/or operations with constant offsets (and divisions by
+// constants for BCD fields). Field widths, payload bounds, value indices
+// and overlapping fields are checked at compile time.
+//
+// Fields which are not covered by whitening (FIELD_RAW) are pre-compensated
+// with the layout's whitening constant, i.e. whitening of the entire payload
+// after packing restores their original value.
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Payload bytes are stored as soon as computed, BCD fields only
+//          convert the digits in the respective byte (as hand-written code)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PAYLOAD_LAYOUT_H
+#define PAYLOAD_LAYOUT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+
+#define FIELD_INVERT    0x01    //!< field is transmitted inverted
+#define FIELD_RAW       0x02    //!< field is not covered by whitening
+
+//! Field coding
+enum struct FieldCode : uint8_t {
+    BIN,    //!< binary
+    BCD     //!< binary coded decimal, one digit per nibble
+};
+
+/*!
+ * \brief Non-negative fixed point value
+ *
+ * Rounded like printf("%.<n>f", x) with scale = 10^n, i.e. to nearest,
+ * ties to even (the product is exact in double precision).
+ *
+ * \param x     value
+ * \param scale scaling factor
+ *
+ * \returns round(x * scale) or 0 if x is negative
+ */
+inline uint32_t fixedPoint(float x, uint32_t scale)
+{
+    return (x > 0) ? (uint32_t)lrint((double)x * scale) : 0;
+}
+
+//! 10^n
+constexpr uint32_t layoutPow10(uint8_t n)
+{
+    return (n == 0) ? 1 : 10 * layoutPow10(n - 1);
+}
+
+//! Mask of the lower n bits
+constexpr uint32_t layoutMask(uint8_t n)
+{
+    return (uint32_t)((1ULL << n) - 1);
+}
+
+//! Whitening constant bits at payload bit positions [pos, pos + n)
+constexpr uint32_t layoutWhitening(uint8_t key, uint16_t pos, uint8_t n)
+{
+    return (n == 0) ? 0 : (layoutWhitening(key, pos, n - 1) << 1) | ((key >> (7 - (pos + n - 1) % 8)) & 1);
+}
+
+//! Conversion of the lower Digits decimal digits to BCD
+template <uint8_t Digits>
+struct LayoutBcd {
+    static inline uint32_t conv(uint32_t v)
+    {
+        return (LayoutBcd<Digits - 1>::conv(v / 10) << 4) | (v % 10);
+    }
+};
+
+template <>
+struct LayoutBcd<0> {
+    static inline uint32_t conv(uint32_t)
+    {
+        return 0;
+    }
+};
+
+//! Shift left by S bits (S >= 0) or right by -S bits (S < 0) - shifts by 32 bits or more yield 0
+template <int S, int Dir = (S >= 32 || S <= -32) ? 0 : (S >= 0) ? 1 : -1>
+struct LayoutShift {
+    static inline uint32_t apply(uint32_t)
+    {
+        return 0;
+    }
+};
+
+template <int S>
+struct LayoutShift<S, 1> {
+    static inline uint32_t apply(uint32_t x)
+    {
+        return x << S;
+    }
+};
+
+template <int S>
+struct LayoutShift<S, -1> {
+    static inline uint32_t apply(uint32_t x)
+    {
+        return x >> -S;
+    }
+};
+
+/*!
+ * \brief Payload field
+ *
+ * \tparam V        index of value
+ * \tparam Pos      bit position of field MSB (0: MSB of byte 0)
+ * \tparam Bits     field width in bits (BCD: 4 * number of digits)
+ * \tparam Code     binary or BCD
+ * \tparam Flags    FIELD_INVERT, FIELD_RAW
+ * \tparam Skip     BIN: value is shifted right by Skip bits,
+ *                  BCD: the lower Skip decimal digits of the value are skipped
+ */
+template <uint8_t V, uint16_t Pos, uint8_t Bits, FieldCode Code, uint8_t Flags, uint8_t Skip>
+struct PayloadField {
+    static_assert(Bits >= 1 && Bits <= 32, "Field width must be 1...32 bits");
+    static_assert(Code != FieldCode::BCD || Bits % 4 == 0, "BCD field width must be a multiple of 4 bits");
+    static_assert(Code != FieldCode::BIN || Skip < 32, "Shift must be less than 32 bits");
+    static_assert(Code != FieldCode::BCD || Skip < 10, "Max. 9 digits can be skipped");
+    static_assert(Code != FieldCode::BCD || Skip + Bits / 4 <= 10, "BCD digits exceed 32-bit value range");
+
+    static const uint8_t value = V;         //!< value index
+    static const uint16_t first = Pos;      //!< first bit
+    static const uint16_t last = Pos + Bits; //!< first bit after field
+
+    //! Bits of payload byte b covered by field
+    static constexpr uint8_t coverage(uint16_t b)
+    {
+        return (last <= 8 * b || first >= 8 * b + 8) ? 0 :
+            (uint8_t)(layoutMask((last < 8 * b + 8 ? last : 8 * b + 8) - (first > 8 * b ? first : 8 * b))
+                << (last < 8 * b + 8 ? 8 * b + 8 - last : 0));
+    }
+
+    /*!
+     * \brief Field bits [Lsb, Msb] (right aligned, other bits undefined)
+     *
+     * BCD: only the digits covering these bits are converted.
+     */
+    template <uint8_t Whitening, int Lsb, int Msb>
+    static inline uint32_t encode(const uint32_t *v)
+    {
+        uint32_t x;
+        if (Code == FieldCode::BCD)
+        {
+            x = LayoutBcd<(Msb / 4 < Bits / 4 - 1 ? Msb / 4 : Bits / 4 - 1) - Lsb / 4 + 1>::conv(
+                    v[V] / layoutPow10(Skip + Lsb / 4)) << (4 * (Lsb / 4));
+        }
+        else
+        {
+            x = (v[V] >> Skip) & layoutMask(Bits);
+        }
+        if (Flags & FIELD_INVERT)
+        {
+            x ^= layoutMask(Bits);
+        }
+        if (Flags & FIELD_RAW)
+        {
+            x ^= layoutWhitening(Whitening, Pos, Bits);
+        }
+        return x;
+    }
+
+    //! Field bits in payload byte B
+    template <uint8_t Whitening, uint16_t B>
+    static inline uint8_t byte(const uint32_t *v)
+    {
+        // Field bits [Lsb, Msb] are located in byte B (not instantiated for other bytes)
+        constexpr int S = 8 * B + 8 - (int)last;
+        constexpr int Lsb = (coverage(B) && S < 0) ? -S : 0;
+        constexpr int Msb = coverage(B) ? 7 - S : 0;
+        return coverage(B) ? (uint8_t)LayoutShift<S>::apply(encode<Whitening, Lsb, Msb>(v)) : 0;
+    }
+};
+
+//! Binary field
+template <uint8_t V, uint16_t Pos, uint8_t Bits, uint8_t Flags = 0, uint8_t Shift = 0>
+using BinField = PayloadField<V, Pos, Bits, FieldCode::BIN, Flags, Shift>;
+
+//! BCD field
+template <uint8_t V, uint16_t Pos, uint8_t Digits, uint8_t Flags = 0, uint8_t Skip = 0>
+using BcdField = PayloadField<V, Pos, 4 * Digits, FieldCode::BCD, Flags, Skip>;
+
+//! Compile time properties of field list
+template <typename... Fields>
+struct LayoutFields {
+    static const bool disjoint = true;
+    static const uint16_t first = 0xFFFF;
+    static const uint16_t last = 0;
+    static const uint8_t values = 0;
+
+    static constexpr uint8_t coverage(uint16_t)
+    {
+        return 0;
+    }
+
+    template <uint8_t Whitening, uint16_t B>
+    static inline uint8_t byte(const uint32_t *)
+    {
+        return 0;
+    }
+};
+
+template <typename F, typename... Rest>
+struct LayoutFields<F, Rest...> {
+    typedef LayoutFields<Rest...> Next;
+
+    //! F does not overlap with any of Rest
+    template <typename... R>
+    struct Apart {
+        static const bool value = true;
+    };
+    template <typename G, typename... R>
+    struct Apart<G, R...> {
+        static const bool value = (F::last <= G::first || G::last <= F::first) && Apart<R...>::value;
+    };
+
+    static const bool disjoint = Apart<Rest...>::value && Next::disjoint;
+    static const uint16_t first = (F::first < Next::first) ? F::first : Next::first;
+    static const uint16_t last = (F::last > Next::last) ? F::last : Next::last;
+    static const uint8_t values = (F::value + 1 > Next::values) ? F::value + 1 : Next::values;
+
+    //! Bits of payload byte b covered by fields
+    static constexpr uint8_t coverage(uint16_t b)
+    {
+        return F::coverage(b) | Next::coverage(b);
+    }
+
+    //! Payload byte B
+    template <uint8_t Whitening, uint16_t B>
+    static inline uint8_t byte(const uint32_t *v)
+    {
+        return F::template byte<Whitening, B>(v) | Next::template byte<Whitening, B>(v);
+    }
+};
+
+//! Packing of payload bytes [B, End)
+template <typename Fields, uint8_t Whitening, uint16_t B, uint16_t End>
+struct LayoutBytes {
+    //! Store bytes - fully covered bytes are assigned, partially covered bytes are ORed
+    static inline void put(uint8_t *payload, const uint32_t *v)
+    {
+        if (Fields::coverage(B) == 0xFF)
+        {
+            payload[B] = Fields::template byte<Whitening, B>(v);
+        }
+        else if (Fields::coverage(B))
+        {
+            payload[B] |= Fields::template byte<Whitening, B>(v);
+        }
+        LayoutBytes<Fields, Whitening, B + 1, End>::put(payload, v);
+    }
+};
+
+template <typename Fields, uint8_t Whitening, uint16_t End>
+struct LayoutBytes<Fields, Whitening, End, End> {
+    static inline void put(uint8_t *, const uint32_t *)
+    {
+    }
+};
+
+/*!
+ * \brief Payload layout
+ *
+ * \tparam Size         payload size in bytes
+ * \tparam Whitening    whitening constant applied to the payload after packing (0: none)
+ * \tparam Fields       BinField/BcdField list
+ */
+template <uint8_t Size, uint8_t Whitening, typename... Fields>
+struct PayloadLayout {
+    typedef LayoutFields<Fields...> List;
+
+    static_assert(sizeof...(Fields) > 0, "Empty layout");
+    static_assert(List::disjoint, "Fields overlap");
+    static_assert(List::last <= 8 * Size, "Field exceeds payload");
+
+    static const uint8_t size = Size;
+    static const uint8_t whitening = Whitening;
+
+    /*!
+     * \brief Pack values into payload
+     *
+     * Payload bytes completely covered by the layout are overwritten,
+     * the fields in other bytes are ORed, i.e. these must be zero-initialized
+     * (or contain only fields of another layout).
+     *
+     * \param payload   payload buffer
+     * \param v         values
+     */
+    template <size_t N>
+    static inline void pack(uint8_t *payload, const uint32_t (&v)[N])
+    {
+        static_assert(List::values <= N, "Value index out of range");
+
+        LayoutBytes<List, Whitening, List::first / 8, (List::last + 7) / 8>::put(payload, v);
+    }
+};
+
+#endif // PAYLOAD_LAYOUT_H
@@ -0,0 +1,322 @@
+///////////////////////////////////////////////////////////////////////////////
+// SensorBatch.h
+//
+// Batch encoding of sensor data records
+//
+// The records of many emulated sensors are stored as structure of arrays
+// (one array per data field), the frames of all records are encoded into
+// a contiguous arena in one call. Frame i of a batch starts at offset
+// i * (FRAME_HEADER_SIZE + payload size) and contains preamble, sync word
+// and (whitened) payload, i.e. it can be passed to the transmitter as is.
+//
+// The payload encoders from PayloadEncoders.h are used, the output is
+// identical to the encoding of a single frame. The structure of arrays is
+// a storage format only, not an encoding optimization: encodeBatch()
+// gathers each record into a SensorRecord (get()) and encodes it like a
+// single frame. The gain of encodeBatch() over encoding frame by frame
+// comes from omitting the encoder lookup and the frame copies.
+// The 6-in-1 message type
+// is stored per record; encodeBatch() does not change it, i.e. the caller
+// selects the message type of the next batch with nextMsgType().
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added 6-in-1 message type per record
+//          Moved SensorRecord to PayloadEncoders.h; measurement values as
+//          scaled integers
+//          Documented structure of arrays as storage format (records are
+//          gathered for encoding)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SENSOR_BATCH_H
+#define SENSOR_BATCH_H
+
+#include "PayloadEncoders.h"
+
+/*!
+ * \brief Sensor data records as structure of arrays
+ *
+ * \tparam N max. number of records
+ */
+template <size_t N>
+struct SensorRecords {
+    size_t count;                   //!< number of valid records
+    uint32_t sensor_id[N];
+    uint8_t s_type[N];
+    uint8_t chan[N];
+    bool startup[N];
+    bool battery_ok[N];
+    int16_t temp_c10[N];            //!< air temperature or soil temperature (SENSOR_TYPE_SOIL)
+    uint8_t humidity[N];            //!< humidity or soil moisture (SENSOR_TYPE_SOIL)
+    uint16_t wind_gust_ms10[N];
+    uint16_t wind_avg_ms10[N];
+    uint16_t wind_dir_deg10[N];
+    uint32_t rain_mm10[N];
+    uint16_t uv10[N];
+    uint32_t light_lux[N];
+    uint16_t strike_count[N];
+    uint8_t distance_km[N];
+    bool alarm[N];
+    uint16_t pm_2_5[N];
+    uint16_t pm_10[N];
+    uint16_t co2_ppm[N];
+    uint16_t hcho_ppb[N];
+    uint8_t voc_level[N];
+    uint8_t msg_type[N];            //!< 6-in-1 message type of next transmission
+
+    SensorRecords() : count(0)
+    {
+    }
+
+    /*!
+     * \brief Store record
+     *
+     * The 6-in-1 message type of a new record is BRESSER_6IN1_MSG_TEMP,
+     * the message type of an existing record is kept.
+     *
+     * \param i     record index
+     * \param s     sensor data (SensorRecord)
+     */
+    template <typename S>
+    void set(size_t i, const S &s)
+    {
+        if (i >= count)
+        {
+            msg_type[i] = BRESSER_6IN1_MSG_TEMP;
+        }
+        sensor_id[i] = s.sensor_id;
+        s_type[i] = s.s_type;
+        chan[i] = s.chan;
+        startup[i] = s.startup;
+        battery_ok[i] = s.battery_ok;
+        temp_c10[i] = 0;
+        humidity[i] = 0;
+        wind_gust_ms10[i] = 0;
+        wind_avg_ms10[i] = 0;
+        wind_dir_deg10[i] = 0;
+        rain_mm10[i] = 0;
+        uv10[i] = 0;
+        light_lux[i] = 0;
+        strike_count[i] = 0;
+        distance_km[i] = 0;
+        alarm[i] = false;
+        pm_2_5[i] = 0;
+        pm_10[i] = 0;
+        co2_ppm[i] = 0;
+        hcho_ppb[i] = 0;
+        voc_level[i] = 0;
+
+        switch (s.s_type)
+        {
+        case SENSOR_TYPE_SOIL:
+            temp_c10[i] = s.soil.temp_c10;
+            humidity[i] = s.soil.moisture;
+            break;
+
+        case SENSOR_TYPE_LEAKAGE:
+            alarm[i] = s.leak.alarm;
+            break;
+
+        case SENSOR_TYPE_LIGHTNING:
+            strike_count[i] = s.lgt.strike_count;
+            distance_km[i] = s.lgt.distance_km;
+            break;
+
+        case SENSOR_TYPE_AIR_PM:
+            pm_2_5[i] = s.pm.pm_2_5;
+            pm_10[i] = s.pm.pm_10;
+            break;
+
+        case SENSOR_TYPE_CO2:
+            co2_ppm[i] = s.co2.co2_ppm;
+            break;
+
+        case SENSOR_TYPE_HCHO_VOC:
+            hcho_ppb[i] = s.voc.hcho_ppb;
+            voc_level[i] = s.voc.voc_level;
+            break;
+
+        default:
+            temp_c10[i] = s.w.temp_c10;
+            humidity[i] = s.w.humidity;
+            wind_gust_ms10[i] = s.w.wind_gust_ms10;
+            wind_avg_ms10[i] = s.w.wind_avg_ms10;
+            wind_dir_deg10[i] = s.w.wind_dir_deg10;
+            rain_mm10[i] = s.w.rain_mm10;
+            uv10[i] = s.w.uv10;
+            light_lux[i] = s.w.light_lux;
+            break;
+        }
+        if (i >= count)
+        {
+            count = i + 1;
+        }
+    }
+
+    /*!
+     * \brief Load record
+     *
+     * \param i     record index
+     * \param rec   sensor data
+     */
+    void get(size_t i, SensorRecord &rec) const
+    {
+        memset(&rec, 0, sizeof(rec));
+        rec.sensor_id = sensor_id[i];
+        rec.s_type = s_type[i];
+        rec.chan = chan[i];
+        rec.startup = startup[i];
+        rec.battery_ok = battery_ok[i];
+        rec.msg_type = msg_type[i];
+
+        switch (s_type[i])
+        {
+        case SENSOR_TYPE_SOIL:
+            rec.soil.temp_c10 = temp_c10[i];
+            rec.soil.moisture = humidity[i];
+            break;
+
+        case SENSOR_TYPE_LEAKAGE:
+            rec.leak.alarm = alarm[i];
+            break;
+
+        case SENSOR_TYPE_LIGHTNING:
+            rec.lgt.strike_count = strike_count[i];
+            rec.lgt.distance_km = distance_km[i];
+            break;
+
+        case SENSOR_TYPE_AIR_PM:
+            rec.pm.pm_2_5 = pm_2_5[i];
+            rec.pm.pm_10 = pm_10[i];
+            break;
+
+        case SENSOR_TYPE_CO2:
+            rec.co2.co2_ppm = co2_ppm[i];
+            break;
+
+        case SENSOR_TYPE_HCHO_VOC:
+            rec.voc.hcho_ppb = hcho_ppb[i];
+            rec.voc.voc_level = voc_level[i];
+            break;
+
+        default:
+            rec.w.temp_c10 = temp_c10[i];
+            rec.w.humidity = humidity[i];
+            rec.w.wind_gust_ms10 = wind_gust_ms10[i];
+            rec.w.wind_avg_ms10 = wind_avg_ms10[i];
+            rec.w.wind_dir_deg10 = wind_dir_deg10[i];
+            rec.w.rain_mm10 = rain_mm10[i];
+            rec.w.uv10 = uv10[i];
+            rec.w.light_lux = light_lux[i];
+            break;
+        }
+    }
+
+    /*!
+     * \brief Advance 6-in-1 message type of consecutive records
+     *
+     * \param first     index of first record
+     * \param n         number of records
+     */
+    void nextMsgType(size_t first, size_t n)
+    {
+        for (size_t i = first; i < first + n && i < count; i++)
+        {
+            msg_type[i] ^= bresser6In1Alternating(s_type[i]);
+        }
+    }
+};
+
+/*!
+ * \brief Encode frames of consecutive records into arena
+ *
+ * Each record is gathered into a SensorRecord and passed to the payload
+ * encoder. Only as many frames as fit into the arena are encoded.
+ *
+ * \tparam Encode       payload encoder, e.g. encodeBresser5In1<SensorRecord>
+ *                      or encodeBresser6In1Record
+ * \tparam PayloadSize  payload size in bytes
+ * \tparam Whitening    whitening constant applied to the payload (0: none)
+ *
+ * \param records       sensor data records
+ * \param first         index of first record
+ * \param n             number of records
+ * \param arena         output buffer
+ * \param arena_size    size of output buffer in bytes
+ *
+ * \returns number of frames encoded
+ */
+template <uint8_t (*Encode)(uint8_t *payload, const SensorRecord &rec), uint8_t PayloadSize, uint8_t Whitening, size_t N>
+size_t encodeBatch(const SensorRecords<N> &records, size_t first, size_t n, uint8_t *arena, size_t arena_size)
+{
+    const size_t stride = FRAME_HEADER_SIZE + PayloadSize;
+
+    if (first >= records.count)
+    {
+        return 0;
+    }
+    if (n > records.count - first)
+    {
+        n = records.count - first;
+    }
+    if (n > arena_size / stride)
+    {
+        n = arena_size / stride;
+    }
+
+    SensorRecord rec;
+    for (size_t i = 0; i < n; i++)
+    {
+        uint8_t *frame = &arena[i * stride];
+        memcpy(frame, frame_header, FRAME_HEADER_SIZE);
+        memset(&frame[FRAME_HEADER_SIZE], 0, PayloadSize);
+        records.get(first + i, rec);
+        Encode(&frame[FRAME_HEADER_SIZE], rec);
+        if (Whitening)
+        {
+            whiten(&frame[FRAME_HEADER_SIZE], PayloadSize, Whitening);
+        }
+    }
+    return n;
+}
+
+//! 6-in-1 encoder with message type from record
+inline uint8_t encodeBresser6In1Record(uint8_t *payload, const SensorRecord &rec)
+{
+    return encodeBresser6In1(payload, rec, rec.msg_type);
+}
+
+#endif // SENSOR_BATCH_H
@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////////
+// SensorFields.h
+//
+// Field table - sensor data record fields by JSON key name
+//
+// The key names (json_keys[], see JsonFilter.h) are mapped to their index by
+// a perfect hash: FNV-1a with a seed for which the 32 bit hash values of all
+// key names differ in their upper 5 bits. Lookup costs one hash of the name
+// and one string compare, independent of the number of keys.
+// If keys are added, a new seed has to be searched (e.g. by trying all seeds
+// from 1 upwards until the table is free of collisions) and the table has
+// to be updated.
+//
+// Does not depend on the Arduino core (usable on the host).
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          setField(): Measurement values are converted to scaled integers
+//          setField(): Unsigned integer fields are clamped to their range
+//          setField(): All values are clamped to the range of the encoders
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SENSOR_FIELDS_H
+#define SENSOR_FIELDS_H
+
+#include <stdint.h>
+#include <string.h>
+
+#include "JsonFilter.h"
+
+#define FIELD_HASH_SEED 0x25CFFUL   //!< FNV-1a seed of perfect hash
+#define FIELD_HASH_BITS 5           //!< hash table size: 2^FIELD_HASH_BITS
+
+//! Perfect hash table - key index (JsonKey) by hash value (-1: none)
+static const int8_t field_hash_table[1 << FIELD_HASH_BITS] = {
+    JK_WIND_AVG, -1, JK_VOC, JK_WIND_GUST,
+    JK_HCHO, -1, JK_ENCODER, JK_MOISTURE,
+    JK_STRIKE_COUNT, JK_RAIN, JK_DISTANCE, -1,
+    JK_UV, JK_PM_2_5, -1, JK_TEMP_C,
+    JK_CHAN, JK_CO2, JK_PM_10, -1,
+    JK_BATTERY_OK, JK_STARTUP, -1, JK_WIND_DIR,
+    JK_S_TYPE, JK_ALARM, -1, JK_HUMIDITY,
+    JK_LIGHT, -1, -1, JK_SENSOR_ID
+};
+
+/*!
+ * \brief Find JSON key by name
+ *
+ * \param name  key name
+ * \param len   length of key name
+ *
+ * \returns key index (JsonKey) or -1 if not found
+ */
+inline int fieldIndex(const char *name, size_t len)
+{
+    uint32_t h = FIELD_HASH_SEED;
+    for (size_t i = 0; i < len; i++)
+    {
+        h = (h ^ (uint8_t)name[i]) * 16777619UL;
+    }
+    int key = field_hash_table[h >> (32 - FIELD_HASH_BITS)];
+    if (key < 0 || strncmp(json_keys[key], name, len) != 0 || json_keys[key][len] != '\0')
+    {
+        return -1;
+    }
+    return key;
+}
+
+//! Find JSON key by name (null terminated)
+inline int fieldIndex(const char *name)
+{
+    return fieldIndex(name, strlen(name));
+}
+
+//! Signed fixed point value - rounded like fixedPoint() (PayloadLayout.h)
+inline int32_t fixedPointSigned(float x, uint32_t scale)
+{
+    return (x < 0) ? -(int32_t)fixedPoint(-x, scale) : (int32_t)fixedPoint(x, scale);
+}
+
+//! Value limited to lo...hi (NaN: 0)
+inline double clampValue(double v, double lo, double hi)
+{
+    return (v >= lo) ? ((v <= hi) ? v : hi) : (v < lo) ? lo : 0;
+}
+
+/*!
+ * \brief Set unsigned integer field
+ *
+ * The value is truncated; negative values (and NaN) are set to 0, values
+ * above max to max (out of range conversions from double are undefined).
+ *
+ * \param field   field of sensor data record
+ * \param v       value
+ * \param max     max. value (default: range of the field)
+ */
+template <typename T>
+inline void setUnsigned(T &field, double v, T max = (T)~(T)0)
+{
+    field = (T)clampValue(v, 0, max);
+}
+
+/*!
+ * \brief Set scaled integer field
+ *
+ * The value is limited to lo...hi (in units of 1/scale) before the
+ * conversion, so it neither wraps in the field nor overflows lrint().
+ *
+ * \param field   field of sensor data record
+ * \param v       value
+ * \param scale   scaling factor
+ * \param lo      min. scaled value
+ * \param hi      max. scaled value
+ */
+template <typename T>
+inline void setScaled(T &field, double v, uint32_t scale, int32_t lo, int32_t hi)
+{
+    field = fixedPointSigned(clampValue(v, (double)lo / scale, (double)hi / scale), scale);
+}
+
+/*!
+ * \brief Set field of sensor data record
+ *
+ * The measurement values are converted to the scaled integers of the record
+ * and clamped to the range which all encoders of the field can represent
+ * (e.g. temperature -99.9...99.9 degC, three BCD digits). The counters (rain
+ * gauge, strike count) are clamped to the widest encoder field; encoders with
+ * fewer digits (5-in-1 rain gauge: 999.9 mm) wrap around like the counter of
+ * the sensor. Negative values of unsigned fields are set to 0. The field of
+ * temp_c depends on the sensor type (soil or weather sensor).
+ * JK_ENCODER is not a field of the record and is ignored.
+ *
+ * \param s     sensor data record (SensorRecord)
+ * \param key   key index (JsonKey)
+ * \param v     value
+ */
+template <typename S>
+void setField(S &s, uint8_t key, double v)
+{
+    switch (key)
+    {
+        case JK_SENSOR_ID:      setUnsigned(s.sensor_id, v); break;
+        case JK_S_TYPE:         setUnsigned<uint8_t>(s.s_type, v, 15); break;
+        case JK_CHAN:           setUnsigned<uint8_t>(s.chan, v, 7); break;
+        case JK_STARTUP:        s.startup = (v != 0); break;
+        case JK_BATTERY_OK:     s.battery_ok = (v != 0); break;
+        case JK_TEMP_C:
+            if (s.s_type == SENSOR_TYPE_SOIL)
+                setScaled(s.soil.temp_c10, v, 10, -999, 999);
+            else
+                setScaled(s.w.temp_c10, v, 10, -999, 999);
+            break;
+        case JK_HUMIDITY:       setUnsigned<uint8_t>(s.w.humidity, v, 99); break;
+        case JK_WIND_GUST:      setScaled(s.w.wind_gust_ms10, v, 10, 0, 999); break;
+        case JK_WIND_AVG:       setScaled(s.w.wind_avg_ms10, v, 10, 0, 999); break;
+        case JK_WIND_DIR:       setScaled(s.w.wind_dir_deg10, v, 10, 0, 3599); break;
+        case JK_RAIN:           setScaled(s.w.rain_mm10, v, 10, 0, 999999); break;
+        case JK_UV:             setScaled(s.w.uv10, v, 10, 0, 999); break;
+        case JK_LIGHT:          setScaled(s.w.light_lux, v, 1000, 0, 999999); break;
+        case JK_MOISTURE:       setUnsigned<uint8_t>(s.soil.moisture, v, 100); break;
+        case JK_PM_2_5:         setUnsigned<uint16_t>(s.pm.pm_2_5, v, 9999); break;
+        case JK_PM_10:          setUnsigned<uint16_t>(s.pm.pm_10, v, 9999); break;
+        case JK_CO2:            setUnsigned<uint16_t>(s.co2.co2_ppm, v, 9999); break;
+        case JK_HCHO:           setUnsigned<uint16_t>(s.voc.hcho_ppb, v, 9999); break;
+        case JK_VOC:            setUnsigned<uint8_t>(s.voc.voc_level, v, 15); break;
+        case JK_STRIKE_COUNT:   setUnsigned<uint16_t>(s.lgt.strike_count, v, 1599); break;
+        case JK_DISTANCE:       setUnsigned(s.lgt.distance_km, v); break;
+        case JK_ALARM:          s.leak.alarm = (v != 0); break;
+        default:                break;
+    }
+}
+
+#endif // SENSOR_FIELDS_H
@@ -40,6 +40,18 @@
 //          Added TRANSCEIVER_CHIP
 // 20231114 Added enum Encoders
 // 20241227 Added LilyGo T3 S3 SX1262/SX1276/LR1121
+// 20261016 Added struct EncoderInfo
+//          Added SERIAL_BAUDRATE and MAX_LINE_LENGTH
+//          Added MAX_FLEET_SIZE, TRAFFIC_SEED and TX_BITRATE
+//          Added MAX_PLAN_SIZE and RADIO_OVERHEAD_BYTES
+//          Added WEATHER_GEN_START_HOUR and WEATHER_GEN_TIME_SCALE
+//          Added STAGE_PROBES
+//          MAX_LINE_LENGTH: 512 -> 2048 (batch updates of multiple sensors)
+//          Added FLEET_IMAGE
+//          Added COMMAND_QUEUE_SIZE
+//          Removed MAX_SENSORS_DEFAULT and WIND_DATA_FLOATINGPOINT (WeatherSensor not used)
+//          AVR: MAX_FLEET_SIZE 2, MAX_LINE_LENGTH 512, MAX_PLAN_SIZE 16 and
+//          COMMAND_QUEUE_SIZE 4 (2.5 kB SRAM)
 //
 // ToDo:
 // -
@@ -51,17 +63,46 @@
 
 #include <Arduino.h>
 
-#define MAX_SENSORS_DEFAULT 1       //!< WeatherSensor - no. of sensors
-#define WIND_DATA_FLOATINGPOINT     //!< WeatherSensor - wind data type
-
 //!< Select one of the following data sources
 //#define DATA_RAW                  //!< payload from raw data
-//#define DATA_GEN                  //!< payload from WeatherSensor::genMessage()
+//#define DATA_GEN                  //!< payload from synthetic weather time series (WeatherGen.h)
 //#define DATA_JSON_CONST             //!< payload from JSON constant string
 #define DATA_JSON_INPUT             //!< payload from JSON serial console input
 
 #define TX_INTERVAL 30              //!< transmit interval in seconds
 
+#define WEATHER_GEN_START_HOUR 8    //!< DATA_GEN - simulated time of day at start
+#define WEATHER_GEN_TIME_SCALE 1    //!< DATA_GEN - simulated seconds per second
+
+#if defined(ARDUINO_ARCH_AVR)
+// 2.5 kB SRAM (e.g. ATmega32U4) - small fleet, single sensor input lines
+#define MAX_FLEET_SIZE 2            //!< max. number of emulated sensors
+#define MAX_PLAN_SIZE 16            //!< max. number of sensors for 'plan=<n>'
+#define MAX_LINE_LENGTH 512         //!< max. length of serial console input line
+#define COMMAND_QUEUE_SIZE 4        //!< command queue entries - power of 2 (CommandQueue.h)
+#else
+#define MAX_FLEET_SIZE 32           //!< max. number of emulated sensors
+#define MAX_PLAN_SIZE 500           //!< max. number of sensors for 'plan=<n>'
+#define MAX_LINE_LENGTH 2048        //!< max. length of serial console input line (batch updates: ~130 bytes per sensor)
+#define COMMAND_QUEUE_SIZE 16       //!< command queue entries - power of 2 (CommandQueue.h)
+#endif
+
+#define TRAFFIC_SEED 1              //!< default seed for traffic model PRNG
+
+#define TX_BITRATE 8.21             //!< bit rate in kbps
+#define RADIO_OVERHEAD_BYTES 7      //!< preamble (32 bits), sync word (16 bits) and length byte added by the transceiver
+
+#define SERIAL_BAUDRATE 115200      //!< serial console baud rate
+
+//#define STAGE_PROBES              //!< cycle counter probes of transmit path stages (StageProbes.h)
+
+#define FLEET_IMAGE "/fleet.bin"    //!< persistent fleet configuration - file in LittleFS (FleetImage.h)
+
+#if defined(FLEET_IMAGE) && !defined(ESP32) && !defined(ESP8266) && !defined(ARDUINO_ARCH_RP2040)
+    #pragma message("FLEET_IMAGE requires LittleFS (ESP32/ESP8266/RP2040); persistent fleet configuration disabled")
+    #undef FLEET_IMAGE
+#endif
+
 enum struct Encoders {
     ENC_BRESSER_5IN1,
     ENC_BRESSER_6IN1,
@@ -70,6 +111,16 @@ enum struct Encoders {
     ENC_BRESSER_LIGHTNING
 };
 
+class FrameWriter;
+
+struct EncoderInfo {
+    Encoders id;                            //!< encoder
+    const char *name;                       //!< encoder name (serial console)
+    uint8_t (*encode)(FrameWriter &frame, int slot); //!< payload encoder function (slot: index in sensor_data)
+    uint8_t size;                           //!< payload size in bytes
+    uint8_t whitening;                      //!< whitening constant applied to the entire payload (0: none)
+};
+
 // ------------------------------------------------------------------------------------------------
 // --- Board ---
 // ------------------------------------------------------------------------------------------------
@@ -56,6 +56,55 @@
 // 20240209 Added CO2 and HCHO/VOC sensors
 // 20240210 Added missing CO2 and HCHO/VOC sensor encoding
 // 20241227 Added LilyGo T3 S3 SX1262/SX1276/LR1121
+// 20261016 Added FrameWriter - preamble, sync word and payload are written
+//          directly into the message buffer
+//          encodeBresser5In1Payload(): Replaced bit counting and inversion loops
+//          by word-wide kernels
+//          Added data whitening as separate step after payload encoding
+//          encodeBresser7In1Payload(): Fixed temperature decimal digit
+//          Replaced blocking serial input and delay() by non-blocking line reader
+//          and millis() based transmit scheduling
+//          Added runtime statistics (serial console command 'stats')
+//          Added emulation of multiple sensors with periodic, jitter, Poisson
+//          and burst traffic models (serial console commands 'fleet', 'traffic'
+//          and 'seed')
+//          Added transmit phase planner for periodic sensors (serial console
+//          command 'plan')
+//          Moved raw payloads, default JSON strings and soil moisture map to
+//          flash; replaced moisture map search by direct lookup table
+//          (moisture index of the nearest step instead of the next lower step)
+//          DATA_GEN: Added synthetic weather time series per sensor
+//          Added transmission on arrival of JSON data for replay of recorded
+//          sensor data (serial console command 'trigger')
+//          Moved payload encoders to PayloadEncoders.h (function templates
+//          over the sensor data record); added batch encoding (SensorBatch.h)
+//          encodeBresser6In1Payload(): Message type per sensor; the frame of
+//          each message type is cached until the sensor data changes
+//          Added cycle counter probes of the transmit path stages
+//          (STAGE_PROBES, serial console command 'probes')
+//          Removed warning on selection of leakage encoder - the digest matches
+//          all captured payloads
+//          deSerialize(): Added JSON filter per encoder and sensor type - only
+//          the consumed keys are stored
+//          Added batch updates of multiple sensors (JSON array or object keyed by
+//          sensor ID) with encoder per sensor
+//          JSON updates only change the fields of the keys present (delta update);
+//          added serial console command 'set <id> <field>=<value>' and re-encoding
+//          of the payload only after data changes (sensors with own data)
+//          Added persistent fleet configuration (FLEET_IMAGE, serial console
+//          command 'config'), loaded at startup
+//          Replaced WeatherSensor::sensor by SensorRecord with measurement values
+//          as scaled integers - converted once on input, the encoders only use
+//          integer arithmetic
+//          Added command queue for input from other tasks or interrupts
+//          (CommandQueue.h), applied by loop() between transmissions
+//          Replaced loop() body by cooperative tasks (Tasks.h): input reader,
+//          one task per emulated sensor, encoder and radio driver; the radio
+//          task uses startTransmit() and the packet sent interrupt, so the next
+//          frame is encoded while the previous one is on air
+//          Replaced Serial.printf() by serialPrintf() (not available on AVR)
+//          Removed WeatherSensor.h - sensor types from PayloadEncoders.h
+//          genData(): Sensor IDs count down from the maximum ID per slot
 //
 // ToDo:
 // -
@@ -65,8 +114,33 @@
 #include "SensorTransmitter.h"
 #include <RadioLib.h>
 #include "logging.h"
-#include "WeatherSensor.h"
+#include "FrameWriter.h"
+#include "PayloadKernels.h"
+#include "LineReader.h"
+#include "TxStats.h"
+#include "StageProbes.h"
+#include "TrafficModel.h"
+#include "SlotPlanner.h"
+#include "WeatherGen.h"
+#include "FleetImage.h"
+#include "CommandQueue.h"
+#include "Tasks.h"
+#include <new>
+#include <stdarg.h>
+
+#ifndef FPSTR
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper *>(p))
+#endif
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+#include "PayloadEncoders.h"
+#include "JsonFilter.h"
+#include "SensorFields.h"
 #include <ArduinoJson.h> // https://github.com/bblanchon/ArduinoJson
+#if defined(FLEET_IMAGE)
+#include <LittleFS.h>
+#endif
 
 #if defined(USE_CC1101)
 static CC1101 radio = new Module(PIN_TRANSCEIVER_CS, PIN_TRANSCEIVER_IRQ, RADIOLIB_NC, PIN_TRANSCEIVER_GPIO);
@@ -87,6 +161,14 @@ static LR1121 radio = new Module(PIN_TRANSCEIVER_CS, PIN_TRANSCEIVER_IRQ, PIN_TR
 static SPIClass *spi = nullptr;
 #endif
 
+// Sensor data per emulated sensor (measurement values as scaled integers)
+static SensorRecord sensor_data[MAX_FLEET_SIZE];
+
+#if defined(DATA_GEN)
+// Weather time series generator per emulated sensor
+static WeatherGen weather_gen[MAX_FLEET_SIZE];
+#endif
+
 #if defined(ARDUINO_LILYGO_T3S3_LR1121)
 static const uint32_t rfswitch_dio_pins[] = {
     RADIOLIB_LR11X0_DIO5, RADIOLIB_LR11X0_DIO6,
@@ -108,7 +190,31 @@ static const Module::RfSwitchMode_t rfswitch_table[] = {
 
 void setup()
 {
-  Serial.begin(115200);
+  Serial.begin(SERIAL_BAUDRATE);
+
+#if defined(DATA_GEN)
+  for (uint8_t i = 0; i < MAX_FLEET_SIZE; i++)
+  {
+    weather_gen[i].begin(TRAFFIC_SEED, i, WEATHER_GEN_START_HOUR * 3600UL, WEATHER_GEN_TIME_SCALE);
+  }
+#endif
+
+#if defined(FLEET_IMAGE)
+  // Fleet configuration of previous session
+#if defined(ESP32)
+  bool fs_mounted = LittleFS.begin(true); // format on first use
+#else
+  bool fs_mounted = LittleFS.begin();
+#endif
+  if (fs_mounted)
+  {
+    configLoad();
+  }
+  else
+  {
+    log_e("LittleFS mount failed!");
+  }
+#endif
 
   #if defined(ARDUINO_LILYGO_T3S3_SX1262) || defined(ARDUINO_LILYGO_T3S3_SX1276) || defined(ARDUINO_LILYGO_T3S3_LR1121)
   spi = new SPIClass(SPI);
@@ -129,14 +235,14 @@ void setup()
   // Preamble: AA AA AA AA AA
   // Sync: 2D D4
 #ifdef USE_CC1101
-  int state = radio.begin(868.3, 8.21, 57.136417, 270, 10, 32);
+  int state = radio.begin(868.3, TX_BITRATE, 57.136417, 270, 10, 32);
 #elif defined(USE_SX1276)
-  int state = radio.beginFSK(868.3, 8.21, 57.136417, 250, 10, 32);
+  int state = radio.beginFSK(868.3, TX_BITRATE, 57.136417, 250, 10, 32);
 #elif defined(USE_SX1262)
-    int state = radio.beginFSK(868.3, 8.21, 57.136417, 234.3, 10, 32);
+    int state = radio.beginFSK(868.3, TX_BITRATE, 57.136417, 234.3, 10, 32);
 #else
     // defined(USE_LR1121)
-    int state = radio.beginGFSK(868.3, 8.21, 57.136417, 234.3, 10, 32);
+    int state = radio.beginGFSK(868.3, TX_BITRATE, 57.136417, 234.3, 10, 32);
 #endif
   if (state == RADIOLIB_ERR_NONE)
   {
@@ -156,921 +262,1118 @@ void setup()
   // LR1121 TCXO Voltage 2.85~3.15V
   radio.setTCXO(3.0);
 #endif
+
+  // Transmissions are started by the radio task, which waits for this interrupt
+  radio.setPacketSentAction(txDoneIsr);
+  tasksBegin();
 }
 
 // counter to keep track of transmitted packets
 int count = 0;
 
-WeatherSensor ws;
-
-int msgBegin(uint8_t *msg)
+void msgBegin(FrameWriter &frame)
 {
-  uint8_t preamble[] = {0xAA, 0xAA, 0xAA, 0xAA};
-  uint8_t syncword[] = {0x2D, 0xD4};
-
-  memcpy(msg, preamble, sizeof(preamble));
-  memcpy(&msg[sizeof(preamble)], syncword, sizeof(syncword));
-
-  return sizeof(preamble) + sizeof(syncword);
+  // Preamble: AA AA AA AA, sync word: 2D D4
+  frame.write(frame_header, FRAME_HEADER_SIZE);
 }
 
 #if defined(DATA_RAW)
-uint8_t rawPayload(Encoders encoder, uint8_t *msg)
+// Captured payloads - index: Encoders
+static const uint8_t raw_payloads[][26] PROGMEM = {
+  // ENC_BRESSER_5IN1
+  {0xEA, 0xEC, 0x7F, 0xEB, 0x5F, 0xEE, 0xEF, 0xFA, 0xFE, 0x76, 0xBB, 0xFA, 0xFF,
+   0x15, 0x13, 0x80, 0x14, 0xA0, 0x11, 0x10, 0x05, 0x01, 0x89, 0x44, 0x05, 0x00},
+  // ENC_BRESSER_6IN1
+  {0x2A, 0xAF, 0x21, 0x10, 0x34, 0x27, 0x18, 0xFF, 0xAA, 0xFF, 0x29, 0x28, 0xFF,
+   0xBB, 0x89, 0xFF, 0x01, 0x1F},
+  // ENC_BRESSER_7IN1
+  {0xC4, 0xD6, 0x3A, 0xC5, 0xBD, 0xFA, 0x18, 0xAA, 0xAA, 0xAA, 0xAA, 0xAB, 0xFC,
+   0xAA, 0x98, 0xDA, 0x89, 0xA3, 0x2F, 0xEC, 0xAF, 0x9A, 0xAA, 0xAA, 0xAA, 0x00},
+  // ENC_BRESSER_LEAKAGE
+  {0xB3, 0xDA, 0x55, 0x57, 0x17, 0x40, 0x53, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00,
+   0x00, 0x00, 0x00, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB},
+  // ENC_BRESSER_LIGHTNING
+  {0x73, 0x69, 0xB5, 0x08, 0xAA, 0xA2, 0x90, 0xAA, 0xAA, 0xAA, 0x00, 0x00, 0x00,
+   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}
+};
+
+// Captured payload sizes - index: Encoders
+static const uint8_t raw_payload_sizes[] PROGMEM = {26, 18, 26, 26, 26};
+
+uint8_t rawPayload(Encoders encoder, FrameWriter &frame)
 {
-  uint8_t payload_5in1[] = {0xEA, 0xEC, 0x7F, 0xEB, 0x5F, 0xEE, 0xEF, 0xFA, 0xFE, 0x76, 0xBB, 0xFA, 0xFF,
-                            0x15, 0x13, 0x80, 0x14, 0xA0, 0x11, 0x10, 0x05, 0x01, 0x89, 0x44, 0x05, 0x00};
-  uint8_t payload_6in1[] = {0x2A, 0xAF, 0x21, 0x10, 0x34, 0x27, 0x18, 0xFF, 0xAA, 0xFF, 0x29, 0x28, 0xFF,
-                            0xBB, 0x89, 0xFF, 0x01, 0x1F};
-  uint8_t payload_7in1[] = {0xC4, 0xD6, 0x3A, 0xC5, 0xBD, 0xFA, 0x18, 0xAA, 0xAA, 0xAA, 0xAA, 0xAB, 0xFC,
-                            0xAA, 0x98, 0xDA, 0x89, 0xA3, 0x2F, 0xEC, 0xAF, 0x9A, 0xAA, 0xAA, 0xAA, 0x00};
-  uint8_t payload_lightning[] = {0x73, 0x69, 0xB5, 0x08, 0xAA, 0xA2, 0x90, 0xAA, 0xAA, 0xAA, 0x00, 0x00, 0x00,
-                                 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
-  uint8_t payload_leakage[] = {0xB3, 0xDA, 0x55, 0x57, 0x17, 0x40, 0x53, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00,
-                               0x00, 0x00, 0x00, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB};
-  if (encoder == Encoders::ENC_BRESSER_5IN1)
-  {
-    memcpy(msg, payload_5in1, 26);
-    return 26;
-  }
-  else if (encoder == Encoders::ENC_BRESSER_6IN1)
-  {
-    memcpy(msg, payload_6in1, 18);
-    return 18;
-  }
-  else if (encoder == Encoders::ENC_BRESSER_7IN1)
-  {
-    memcpy(msg, payload_7in1, 26);
-    return 26;
-  }
-  else if (encoder == Encoders::ENC_BRESSER_LIGHTNING)
-  {
-    memcpy(msg, payload_lightning, 26);
-    return 26;
-  }
-  else if (encoder == Encoders::ENC_BRESSER_LEAKAGE)
-  {
-    memcpy(msg, payload_leakage, 26);
-    return 26;
-  }
-  else
+  uint8_t idx = static_cast<uint8_t>(encoder);
+
+  if (idx >= sizeof(raw_payload_sizes))
   {
     log_e("Encoder not supported!");
     return 0;
   }
+  uint8_t size = pgm_read_byte(&raw_payload_sizes[idx]);
+  frame.write_P(raw_payloads[idx], size);
+  return size;
 }
 #endif
 
 #if defined(DATA_GEN)
-void genData(Encoders encoder)
+void genData(Encoders encoder, uint8_t slot)
 {
+  SensorRecord &s = sensor_data[slot];
+
   if (encoder == Encoders::ENC_BRESSER_5IN1)
   {
-    ws.genMessage(0 /* slot */, 0xff /* id */, SENSOR_TYPE_WEATHER0 /* s_type */);
+    s.sensor_id = 0xff - slot;
+    s.s_type = SENSOR_TYPE_WEATHER0;
   }
   else if (encoder == Encoders::ENC_BRESSER_6IN1)
   {
-    ws.genMessage(0 /* slot */, 0xFFFFFFFF /* id */, SENSOR_TYPE_WEATHER1 /* s_type */);
+    s.sensor_id = 0xFFFFFFFF - slot;
+    s.s_type = SENSOR_TYPE_WEATHER1;
   }
   else if (encoder == Encoders::ENC_BRESSER_7IN1)
   {
-    ws.genMessage(0 /* slot */, 0xFFFF /* id */, SENSOR_TYPE_WEATHER1 /* s_type */);
+    s.sensor_id = 0xFFFF - slot;
+    s.s_type = SENSOR_TYPE_WEATHER1;
   }
   else if (encoder == Encoders::ENC_BRESSER_LIGHTNING)
   {
-    ws.genMessage(0 /* slot */, 0xFFFF /* id */, SENSOR_TYPE_LIGHTNING /* s_type */);
+    s.sensor_id = 0xFFFF - slot;
+    s.s_type = SENSOR_TYPE_LIGHTNING;
   }
   else if (encoder == Encoders::ENC_BRESSER_LEAKAGE)
   {
-    ws.genMessage(0 /* slot */, 0xFFFFFFFF /* id */, SENSOR_TYPE_LEAKAGE /* s_type */);
+    s.sensor_id = 0xFFFFFFFF - slot;
+    s.s_type = SENSOR_TYPE_LEAKAGE;
   }
   else
   {
     log_e("Encoder not supported!");
+    return;
   }
+  s.chan = 0;
+  s.startup = false;
+  s.battery_ok = true;
+  weather_gen[slot].update(s, millis());
 }
 #endif
 
 #if defined(DATA_JSON_CONST)
-void genJson(Encoders encoder, String &json_str)
-{
-  const String json_5in1 =
-      "{\"sensor_id\":255,\"s_type\":1,\"chan\":0,\"startup\":0,\"battery_ok\":1,\"temp_c\":12.3,\
-      \"humidity\":44,\"wind_gust_meter_sec\":3.3,\"wind_avg_meter_sec\":2.2,\"wind_direction_deg\":111.1,\
-      \"rain_mm\":123.4}";
+static const char json_5in1[] PROGMEM =
+    "{\"sensor_id\":255,\"s_type\":1,\"chan\":0,\"startup\":0,\"battery_ok\":1,\"temp_c\":12.3,\
+    \"humidity\":44,\"wind_gust_meter_sec\":3.3,\"wind_avg_meter_sec\":2.2,\"wind_direction_deg\":111.1,\
+    \"rain_mm\":123.4}";
 
-  const String json_6in1 =
-      "{\"sensor_id\":4294967295,\"s_type\":1,\"chan\":0,\"startup\":0,\"battery_ok\":1,\"temp_c\":12.3,\
-      \"humidity\":44,\"wind_gust_meter_sec\":3.3,\"wind_avg_meter_sec\":2.2,\"wind_direction_deg\":111.1,\
-      \"rain_mm\":12345.6,\"uv\":7.8}";
+static const char json_6in1[] PROGMEM =
+    "{\"sensor_id\":4294967295,\"s_type\":1,\"chan\":0,\"startup\":0,\"battery_ok\":1,\"temp_c\":12.3,\
+    \"humidity\":44,\"wind_gust_meter_sec\":3.3,\"wind_avg_meter_sec\":2.2,\"wind_direction_deg\":111.1,\
+    \"rain_mm\":12345.6,\"uv\":7.8}";
 
-  const String json_7in1 =
-      "{\"sensor_id\":65535,\"s_type\":1,\"chan\":0,\"startup\":0,\"battery_ok\":1,\"temp_c\":12.3,\
-      \"humidity\":44,\"wind_gust_meter_sec\":3.3,\"wind_avg_meter_sec\":2.2,\"wind_direction_deg\":111.1,\
-      \"rain_mm\":12345.6}";
+static const char json_7in1[] PROGMEM =
+    "{\"sensor_id\":65535,\"s_type\":1,\"chan\":0,\"startup\":0,\"battery_ok\":1,\"temp_c\":12.3,\
+    \"humidity\":44,\"wind_gust_meter_sec\":3.3,\"wind_avg_meter_sec\":2.2,\"wind_direction_deg\":111.1,\
+    \"rain_mm\":12345.6}";
 
-  const String json_lightning =
-      "{\"sensor_id\":65535,\"s_type\":9,\"chan\":0,\"startup\":0,\"battery_ok\":1,\"strike_count\":22,\
-      \"distance_km\":44}";
+static const char json_lightning[] PROGMEM =
+    "{\"sensor_id\":65535,\"s_type\":9,\"chan\":0,\"startup\":0,\"battery_ok\":1,\"strike_count\":22,\
+    \"distance_km\":44}";
 
-  const String json_leakage = "{\"sensor_id\":4294967295,\"s_type\":5,\"chan\":0,\"startup\":0,\"battery_ok\":1,\"alarm\":1}";
+static const char json_leakage[] PROGMEM = "{\"sensor_id\":4294967295,\"s_type\":5,\"chan\":0,\"startup\":0,\"battery_ok\":1,\"alarm\":1}";
 
-  if (encoder == Encoders::ENC_BRESSER_5IN1)
-  {
-    json_str = json_5in1;
-  }
-  else if (encoder == Encoders::ENC_BRESSER_6IN1)
-  {
-    json_str = json_6in1;
-  }
-  else if (encoder == Encoders::ENC_BRESSER_7IN1)
-  {
-    json_str = json_7in1;
-  }
-  else if (encoder == Encoders::ENC_BRESSER_LIGHTNING)
-  {
-    json_str = json_lightning;
-  }
-  else if (encoder == Encoders::ENC_BRESSER_LEAKAGE)
-  {
-    json_str = json_leakage;
-  }
-  else
+// Default JSON strings - index: Encoders
+static const char *const json_default[] PROGMEM = {json_5in1, json_6in1, json_7in1, json_leakage, json_lightning};
+
+void genJson(Encoders encoder, String &json_str)
+{
+  uint8_t idx = static_cast<uint8_t>(encoder);
+
+  if (idx >= sizeof(json_default) / sizeof(json_default[0]))
   {
     log_e("Encoder not supported!");
+    return;
   }
+  json_str = FPSTR(pgm_read_ptr(&json_default[idx]));
 }
 #endif
 
 #if defined(DATA_JSON_INPUT) || defined(DATA_JSON_CONST)
-bool deSerialize(Encoders encoder, String json_str)
+//
+// Copy sensor data from JSON object
+// Only the fields of the keys present are changed (delta update); keys not used
+// by the encoder and sensor type are ignored. A changed sensor type starts with
+// an empty record. The measurement values are converted to scaled integers.
+//
+bool jsonSensor(Encoders encoder, JsonVariantConst doc, SensorRecord &sensor)
 {
-  JsonDocument doc;
-
-  // Deserialize the JSON document
-  DeserializationError error = deserializeJson(doc, json_str.c_str());
-
-  // Test if parsing succeeded
-  if (error)
+  if (!doc.is<JsonObjectConst>())
   {
-    log_e("DeserializeJson() failed: %s", error.f_str());
+    log_e("JSON object expected!");
     return false;
   }
 
-  ws.sensor[0].sensor_id = doc["sensor_id"];
-  ws.sensor[0].s_type = doc["s_type"];
-  ws.sensor[0].chan = doc["chan"];
-  ws.sensor[0].startup = doc["startup"];
-  ws.sensor[0].battery_ok = doc["battery_ok"];
-
-  if (encoder == Encoders::ENC_BRESSER_5IN1)
+  // The sensor type selects the fields
+  JsonVariantConst s_type = doc["s_type"];
+  if (!s_type.isNull() && s_type.as<uint8_t>() != sensor.s_type)
   {
-    ws.sensor[0].w.temp_c = doc["temp_c"];
-    ws.sensor[0].w.humidity = doc["humidity"];
-    ws.sensor[0].w.wind_gust_meter_sec = doc["wind_gust_meter_sec"];
-    ws.sensor[0].w.wind_avg_meter_sec = doc["wind_avg_meter_sec"];
-    ws.sensor[0].w.wind_direction_deg = doc["wind_direction_deg"];
-    ws.sensor[0].w.rain_mm = doc["rain_mm"];
+    sensor = SensorRecord();
+    sensor.s_type = s_type.as<uint8_t>();
   }
-  else if (encoder == Encoders::ENC_BRESSER_6IN1)
+  uint32_t keys = jsonKeys(static_cast<uint8_t>(encoder), sensor.s_type);
+
+  for (JsonPairConst kv : doc.as<JsonObjectConst>())
   {
-    if (ws.sensor[0].s_type == SENSOR_TYPE_SOIL)
+    int key = fieldIndex(kv.key().c_str(), kv.key().size());
+    if (key >= 0 && (keys & JK(key)))
     {
-      ws.sensor[0].soil.temp_c = doc["temp_c"];
-      ws.sensor[0].soil.moisture = doc["moisture"];
-    }
-    else
-    {
-      ws.sensor[0].w.temp_c = doc["temp_c"];
-      ws.sensor[0].w.humidity = doc["humidity"];
-      ws.sensor[0].w.wind_gust_meter_sec = doc["wind_gust_meter_sec"];
-      ws.sensor[0].w.wind_avg_meter_sec = doc["wind_avg_meter_sec"];
-      ws.sensor[0].w.wind_direction_deg = doc["wind_direction_deg"];
-      ws.sensor[0].w.rain_mm = doc["rain_mm"];
-      ws.sensor[0].w.uv = doc["uv"];
+      setField(sensor, key, kv.value().as<double>());
     }
   }
-  else if (encoder == Encoders::ENC_BRESSER_7IN1)
+  return true;
+}
+
+bool deSerialize(Encoders encoder, const char *json_str, SensorRecord &sensor)
+{
+  // Filter - only the keys consumed by jsonSensor() are stored (see JsonFilter.h);
+  // rebuilt if encoder or sensor type change
+  static JsonDocument filter;
+  static uint32_t filter_keys = 0;
+
+  JsonDocument doc;
+  int s_type = jsonSType(json_str);
+  DeserializationError error;
+
+  for (;;)
   {
-    if (ws.sensor[0].s_type == SENSOR_TYPE_WEATHER1)
-    {
-      ws.sensor[0].w.temp_c = doc["temp_c"];
-      ws.sensor[0].w.humidity = doc["humidity"];
-      ws.sensor[0].w.wind_gust_meter_sec = doc["wind_gust_meter_sec"];
-      ws.sensor[0].w.wind_avg_meter_sec = doc["wind_avg_meter_sec"];
-      ws.sensor[0].w.wind_direction_deg = doc["wind_direction_deg"];
-      ws.sensor[0].w.rain_mm = doc["rain_mm"];
-      ws.sensor[0].w.uv = doc["uv"];
-      ws.sensor[0].w.light_klx = doc["light_klx"];
-    }
-    else if (ws.sensor[0].s_type == SENSOR_TYPE_AIR_PM)
-    {
-      ws.sensor[0].pm.pm_2_5 = doc["pm_2_5"];
-      ws.sensor[0].pm.pm_10 = doc["pm_10"];
-    }
-    else if (ws.sensor[0].s_type == SENSOR_TYPE_CO2)
-    {
-      ws.sensor[0].co2.co2_ppm = doc["co2_ppm"];
-    }
-    else if (ws.sensor[0].s_type == SENSOR_TYPE_HCHO_VOC)
+    uint32_t keys = jsonKeys(static_cast<uint8_t>(encoder), s_type);
+    if (keys != filter_keys)
     {
-      ws.sensor[0].voc.hcho_ppb = doc["hcho_ppb"];
-      ws.sensor[0].voc.voc_level = doc["voc"];
+      jsonFilter(filter, keys);
+      filter_keys = keys;
     }
+
+    // Deserialize the JSON document
+    error = deserializeJson(doc, json_str, DeserializationOption::Filter(filter));
+
+    // Sensor type from pre-scan does not match (e.g. escaped key) - parse again with
+    // the keys of all sensor types of the encoder
+    if (error || s_type < 0 || doc["s_type"].as<int>() == s_type)
+      break;
+    s_type = -1;
   }
-  else if (encoder == Encoders::ENC_BRESSER_LIGHTNING)
-  {
-    ws.sensor[0].lgt.strike_count = doc["strike_count"];
-    ws.sensor[0].lgt.distance_km = doc["distance_km"];
-  }
-  else if (encoder == Encoders::ENC_BRESSER_LEAKAGE)
-  {
-    ws.sensor[0].leak.alarm = doc["alarm"];
-  }
-  else
+
+  // Test if parsing succeeded
+  if (error)
   {
-    log_e("Encoder not supported!");
+    log_e("DeserializeJson() failed: %s", error.f_str());
     return false;
   }
-  return true;
+
+  return jsonSensor(encoder, doc, sensor);
 }
 #endif
 
 //
-// From from rtl_433 project - https://github.com/merbanan/rtl_433/blob/master/src/devices/bresser_5in1.c (20220212)
-//
-// Example input data:
-//   00 01 02 03 04 05 06 07 08 09 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25
-//   EA EC 7F EB 5F EE EF FA FE 76 BB FA FF 15 13 80 14 A0 11 10 05 01 89 44 05 00
-//   CC CC CC CC CC CC CC CC CC CC CC CC CC uu II sS GG DG WW  W TT  T HH RR RR Bt
-// - C = Check, inverted data of 13 byte further
-// - uu = checksum (number/count of set bits within bytes 14-25)
-// - I = station ID (maybe)
-// - G = wind gust in 1/10 m/s, normal binary coded, GGxG = 0x76D1 => 0x0176 = 256 + 118 = 374 => 37.4 m/s.  MSB is out of sequence.
-// - D = wind direction 0..F = N..NNE..E..S..W..NNW
-// - W = wind speed in 1/10 m/s, BCD coded, WWxW = 0x7512 => 0x0275 = 275 => 27.5 m/s. MSB is out of sequence.
-// - T = temperature in 1/10 °C, BCD coded, TTxT = 1203 => 31.2 °C
-// - t = temperature sign, minus if unequal 0
-// - H = humidity in percent, BCD coded, HH = 23 => 23 %
-// - R = rain in mm, BCD coded, RRRR = 1203 => 031.2 mm
-// - B = Battery. 0=Ok, 8=Low.
-// - s = startup, 0 after power-on/reset / 8 after 1 hour
-// - S = sensor type, only low nibble used, 0x9 for Bresser Professional Rain Gauge
-uint8_t encodeBresser5In1Payload(uint8_t *msg)
+// Payload encoders for emulated sensor data - see PayloadEncoders.h
+//
+uint8_t encodeBresser5In1Payload(FrameWriter &frame, int slot)
 {
-  uint8_t payload[26] = {0};
-  char buf[7];
-
-  payload[14] = (uint8_t)(ws.sensor[0].sensor_id & 0xFF);
-  payload[15] = ((ws.sensor[0].startup ? 0 : 8) << 4) | ws.sensor[0].s_type;
+  return encodeBresser5In1(frame.reserve(26), sensor_data[slot]);
+}
 
-  uint16_t wind = ws.sensor[0].w.wind_gust_meter_sec * 10;
-  payload[16] = wind & 0xFF;
-  payload[17] = (wind >> 8) & 0xF;
+// Message type and cached frames per emulated 6-in-1 sensor
+static Bresser6In1Frames<SensorRecord> frames_6in1[MAX_FLEET_SIZE];
 
-  uint8_t wdir = ws.sensor[0].w.wind_direction_deg / 22.5f;
-  payload[17] |= wdir << 4;
+uint8_t encodeBresser6In1Payload(FrameWriter &frame, int slot)
+{
+  return frames_6in1[slot].encode(frame.reserve(BRESSER_6IN1_SIZE), sensor_data[slot]);
+}
 
-  snprintf(buf, 7, "%04.1f", ws.sensor[0].w.wind_avg_meter_sec);
-  payload[18] = ((buf[1] - '0') << 4) | (buf[3] - '0');
-  payload[19] = buf[0] - '0';
+uint8_t encodeBresser7In1Payload(FrameWriter &frame, int slot)
+{
+  return encodeBresser7In1(frame.reserve(26), sensor_data[slot]);
+}
 
-  float temp_c = ws.sensor[0].w.temp_c;
-  if (temp_c < 0)
-  {
-    temp_c *= -1;
-    payload[25] = 1;
-  }
-  else
-  {
-    payload[25] = 0;
-  }
+uint8_t encodeBresserLightningPayload(FrameWriter &frame, int slot)
+{
+  return encodeBresserLightning(frame.reserve(10), sensor_data[slot]);
+}
 
-  snprintf(buf, 7, "%04.1f", temp_c);
-  payload[20] = ((buf[1] - '0') << 4) | (buf[3] - '0');
-  payload[21] = buf[0] - '0';
+uint8_t encodeBresserLeakagePayload(FrameWriter &frame, int slot)
+{
+  return encodeBresserLeakage(frame.reserve(10), sensor_data[slot]);
+}
 
-  snprintf(buf, 7, "%02d", ws.sensor[0].w.humidity);
-  payload[22] = ((buf[0] - '0') << 4) | (buf[1] - '0');
+// Payload encoders
+// Whitening is applied to the entire payload after encoding;
+// fields not covered by whitening are pre-compensated by the encoders.
+static const EncoderInfo encoder_info[] = {
+  {Encoders::ENC_BRESSER_5IN1, "bresser-5in1", encodeBresser5In1Payload, 26, 0},
+  {Encoders::ENC_BRESSER_6IN1, "bresser-6in1", encodeBresser6In1Payload, 18, 0},
+  {Encoders::ENC_BRESSER_7IN1, "bresser-7in1", encodeBresser7In1Payload, 26, WHITENING_BRESSER_7IN1},
+  {Encoders::ENC_BRESSER_LEAKAGE, "bresser-leakage", encodeBresserLeakagePayload, 10, 0},
+  {Encoders::ENC_BRESSER_LIGHTNING, "bresser-lightning", encodeBresserLightningPayload, 10, WHITENING_BRESSER_LIGHTNING}
+};
 
-  snprintf(buf, 7, "%05.1f", ws.sensor[0].w.rain_mm);
-  payload[23] = ((buf[2] - '0') << 4) | (buf[4] - '0');
-  payload[24] = ((buf[0] - '0') << 4) | (buf[1] - '0');
+static Encoders encoder = Encoders::ENC_BRESSER_6IN1;
+static unsigned tx_interval = TX_INTERVAL;
+static String json_str;
+static SensorRecord json_sensor; // sensor data from JSON string
+static LineReader<MAX_LINE_LENGTH + 1> line_reader;
+static TxStats tx_stats;
+static StatsFormat stats_request = StatsFormat::NONE;
+static MpscQueue<Command, COMMAND_QUEUE_SIZE> command_queue; // commands from other tasks or interrupts
+static uint32_t command_queue_dropped = 0;
+#if defined(STAGE_PROBES)
+StageProbes stage_probes;
+static bool probes_request = false;
+#endif
 
-  payload[25] |= (ws.sensor[0].battery_ok ? 0 : 8) << 4;
+// Transmission request of emulated sensor (encoder task)
+enum class TxRequest : uint8_t {
+  NONE,
+  SCHEDULE, // due according to traffic model
+  INPUT     // replay of input ('trigger=input')
+};
 
-  // Calculate checksum (number number bits set in bytes 14-25)
-  uint8_t bitsSet = 0;
+// Emulated sensors
+// Sensors without own data use the selected encoder and the same data; the
+// sensor ID is incremented for each sensor. Sensors updated by a batch update
+// (JSON array or keyed object) keep their own data and encoder.
+static struct {
+  TrafficModel traffic; // arrival process
+  uint32_t next_tx;     // time of next transmission in ms
+  uint32_t tx_due;      // time of requested transmission in ms
+  TxRequest tx_request; // transmission requested
+  Encoders encoder;     // encoder (own data only)
+  bool own_data;        // sensor data from batch update or 'set'
+  bool updated;         // data updated by last input line (transmitted with 'trigger=input')
+  bool dirty;           // data changed since payload was encoded (own data only)
+} fleet[MAX_FLEET_SIZE];
+
+// Encoded frame - from encoder task to radio task
+static struct {
+  uint8_t data[40];
+  uint8_t size;
+  Encoders enc;
+  bool ready; // encoded, not yet written to the transceiver
+} tx_frame;
+static Event tx_done; // end of transmission (packet sent interrupt)
+
+// Encoded (and whitened) payload per sensor with own data; re-encoded if
+// data changed - except 6-in-1 (alternating messages, see Bresser6In1Frames)
+static uint8_t payload_cache[MAX_FLEET_SIZE][26];
+static uint8_t fleet_size = 1;
+static uint32_t traffic_seed = TRAFFIC_SEED;
+static bool fleet_restart = true;
+static bool tx_on_input = false; // transmit on arrival of JSON data instead of schedule
+static SlotPlanner<MAX_FLEET_SIZE> planner;
+static uint32_t fleet_epoch; // start of schedule in ms
+
+static const char *const traffic_names[] = {"periodic", "jitter", "poisson", "burst"};
 
-  for (uint8_t p = 14; p < 26; p++)
+//
+// Find encoder by name (prefix match, ignoring case)
+//
+const EncoderInfo *findEncoder(const char *name)
+{
+  for (const EncoderInfo &e : encoder_info)
   {
-    uint8_t currentByte = payload[p];
-    while (currentByte)
+    if (strncasecmp(name, e.name, strlen(e.name)) == 0)
     {
-      bitsSet += (currentByte & 1);
-      currentByte >>= 1;
+      return &e;
     }
   }
-  payload[13] = bitsSet;
-  log_d("Bits set: 0x%02X", bitsSet);
-
-  // First 13 bytes are inverse of last 13 bytes
-  for (unsigned col = 0; col < 26 / 2; ++col)
-  {
-    payload[col] = ~payload[col + 13];
-  }
-
-  memcpy(msg, payload, 26);
-
-  // Return message size
-  return 26;
+  return nullptr;
 }
 
 //
-// From from rtl_433 project - https://github.com/merbanan/rtl_433/blob/master/src/devices/bresser_6in1.c (20220608)
-//
-// - also Bresser Weather Center 7-in-1 indoor sensor.
-// - also Bresser new 5-in-1 sensors.
-// - also Froggit WH6000 sensors.
-// - also rebranded as Ventus C8488A (W835)
-// - also Bresser 3-in-1 Professional Wind Gauge / Anemometer PN 7002531
-// - also Bresser Pool / Spa Thermometer PN 7009973 (s_type = 3)
-//
-// There are at least two different message types:
-// - 24 seconds interval for temperature, hum, uv and rain (alternating messages)
-// - 12 seconds interval for wind data (every message)
-//
-// Also Bresser Explore Scientific SM60020 Soil moisture Sensor.
-// https://www.bresser.de/en/Weather-Time/Accessories/EXPLORE-SCIENTIFIC-Soil-Moisture-and-Soil-Temperature-Sensor.html
-//
-// Moisture:
-//
-//     f16e 187000e34 7 ffffff0000 252 2 16 fff 004 000 [25,2, 99%, CH 7]
-//     DIGEST:8h8h ID?8h8h8h8h TYPE:4h STARTUP:1b CH:3d 8h 8h8h 8h8h TEMP:12h ?2b BATT:1b ?1b MOIST:8h UV?~12h ?4h CHKSUM:8h
-//
-// Moisture is transmitted in the humidity field as index 1-16: 0, 7, 13, 20, 27, 33, 40, 47, 53, 60, 67, 73, 80, 87, 93, 99.
-// The Wind speed and direction fields decode to valid zero but we exclude them from the output.
-//
-//     aaaa2dd4e3ae1870079341ffffff0000221201fff279 [Batt ok]
-//     aaaa2dd43d2c1870079341ffffff0000219001fff2fc [Batt low]
-//
-//     {206}55555555545ba83e803100058631ff11fe6611ffffffff01cc00 [Hum 96% Temp 3.8 C Wind 0.7 m/s]
-//     {205}55555555545ba999263100058631fffffe66d006092bffe0cff8 [Hum 95% Temp 3.0 C Wind 0.0 m/s]
-//     {199}55555555545ba840523100058631ff77fe668000495fff0bbe [Hum 95% Temp 3.0 C Wind 0.4 m/s]
-//     {205}55555555545ba94d063100058631fffffe665006092bffe14ff8
-//     {206}55555555545ba860703100058631fffffe6651ffffffff0135fc [Hum 95% Temp 3.0 C Wind 0.0 m/s]
-//     {205}55555555545ba924d23100058631ff99fe68b004e92dffe073f8 [Hum 96% Temp 2.7 C Wind 0.4 m/s]
-//     {202}55555555545ba813403100058631ff77fe6810050929ffe1180 [Hum 94% Temp 2.8 C Wind 0.4 m/s]
-//     {205}55555555545ba98be83100058631fffffe6130050929ffe17800 [Hum 95% Temp 2.8 C Wind 0.8 m/s]
-//
-//     2dd4  1f 40 18 80 02 c3 18 ff 88 ff 33 08 ff ff ff ff 80 e6 00 [Hum 96% Temp 3.8 C Wind 0.7 m/s]
-//     2dd4  cc 93 18 80 02 c3 18 ff ff ff 33 68 03 04 95 ff f0 67 3f [Hum 95% Temp 3.0 C Wind 0.0 m/s]
-//     2dd4  20 29 18 80 02 c3 18 ff bb ff 33 40 00 24 af ff 85 df    [Hum 95% Temp 3.0 C Wind 0.4 m/s]
-//     2dd4  a6 83 18 80 02 c3 18 ff ff ff 33 28 03 04 95 ff f0 a7 3f
-//     2dd4  30 38 18 80 02 c3 18 ff ff ff 33 28 ff ff ff ff 80 9a 7f [Hum 95% Temp 3.0 C Wind 0.0 m/s]
-//     2dd4  92 69 18 80 02 c3 18 ff cc ff 34 58 02 74 96 ff f0 39 3f [Hum 96% Temp 2.7 C Wind 0.4 m/s]
-//     2dd4  09 a0 18 80 02 c3 18 ff bb ff 34 08 02 84 94 ff f0 8c 0  [Hum 94% Temp 2.8 C Wind 0.4 m/s]
-//     2dd4  c5 f4 18 80 02 c3 18 ff ff ff 30 98 02 84 94 ff f0 bc 00 [Hum 95% Temp 2.8 C Wind 0.8 m/s]
-//
-//     {147} 5e aa 18 80 02 c3 18 fa 8f fb 27 68 11 84 81 ff f0 72 00 [Temp 11.8 C  Hum 81%]
-//     {149} ae d1 18 80 02 c3 18 fa 8d fb 26 78 ff ff ff fe 02 db f0
-//     {150} f8 2e 18 80 02 c3 18 fc c6 fd 26 38 11 84 81 ff f0 68 00 [Temp 11.8 C  Hum 81%]
-//     {149} c4 7d 18 80 02 c3 18 fc 78 fd 29 28 ff ff ff fe 03 97 f0
-//     {149} 28 1e 18 80 02 c3 18 fb b7 fc 26 58 ff ff ff fe 02 c3 f0
-//     {150} 21 e8 18 80 02 c3 18 fb 9c fc 33 08 11 84 81 ff f0 b7 f8 [Temp 11.8 C  Hum 81%]
-//     {149} 83 ae 18 80 02 c3 18 fc 78 fc 29 28 ff ff ff fe 03 98 00
-//     {150} 5c e4 18 80 02 c3 18 fb ba fc 26 98 11 84 81 ff f0 16 00 [Temp 11.8 C  Hum 81%]
-//     {148} d0 bd 18 80 02 c3 18 f9 ad fa 26 48 ff ff ff fe 02 ff f0
-//
-// Wind and Temperature/Humidity or Rain:
-//
-//     DIGEST:8h8h ID:8h8h8h8h TYPE:4h STARTUP:1b CH:3d WSPEED:~8h~4h ~4h~8h WDIR:12h ?4h TEMP:8h.4h ?2b BATT:1b ?1b HUM:8h UV?~12h ?4h CHKSUM:8h
-//     DIGEST:8h8h ID:8h8h8h8h TYPE:4h STARTUP:1b CH:3d WSPEED:~8h~4h ~4h~8h WDIR:12h ?4h RAINFLAG:8h RAIN:8h8h UV:8h8h CHKSUM:8h
-//
-// Digest is LFSR-16 gen 0x8810 key 0x5412, excluding the add-checksum and trailer.
-// Checksum is 8-bit add (with carry) to 0xff.
-//
-// Notes on different sensors:
-//
-// - 1910 084d 18 : RebeckaJohansson, VENTUS W835
-// - 2030 088d 10 : mvdgrift, Wi-Fi Colour Weather Station with 5in1 Sensor, Art.No.: 7002580, ff 01 in the UV field is (obviously) invalid.
-// - 1970 0d57 18 : danrhjones, bresser 5-in-1 model 7002580, no UV
-// - 18b0 0301 18 : konserninjohtaja 6-in-1 outdoor sensor
-// - 18c0 0f10 18 : rege245 BRESSER-PC-Weather-station-with-6-in-1-outdoor-sensor
-// - 1880 02c3 18 : f4gqk 6-in-1
-// - 18b0 0887 18 : npkap
-uint8_t encodeBresser6In1Payload(uint8_t *msg)
+// Airtime of a frame in microseconds
+//
+uint32_t frameAirtimeUs(Encoders enc)
 {
-  static int msg_type;
-  char buf[8];
-  uint8_t payload[18] = {0};
-
-  payload[2] = ws.sensor[0].sensor_id >> 24;
-  payload[3] = (ws.sensor[0].sensor_id >> 16) & 0xFF;
-  payload[4] = (ws.sensor[0].sensor_id >> 8) & 0xFF;
-  payload[5] = (ws.sensor[0].sensor_id) & 0xFF;
-  payload[6] = ws.sensor[0].s_type << 4;
-  payload[6] |= (ws.sensor[0].startup ? 0 : 8) | ws.sensor[0].chan;
-
-  snprintf(buf, 7, "%04.1f", ws.sensor[0].w.wind_gust_meter_sec);
-  log_d("Wind gust: %04.1f", ws.sensor[0].w.wind_gust_meter_sec);
-  payload[7] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-  payload[8] = (buf[3] - '0') << 4;
-
-  snprintf(buf, 7, "%04.1f", ws.sensor[0].w.wind_avg_meter_sec);
-  log_d("Wind avg: %04.1f", ws.sensor[0].w.wind_avg_meter_sec);
-  payload[9] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-  payload[8] |= buf[3] - '0';
-
-  // Invert bytes
-  payload[7] ^= 0xFF;
-  payload[8] ^= 0xFF;
-  payload[9] ^= 0xFF;
-
-  snprintf(buf, 7, "%03d", (int)ws.sensor[0].w.wind_direction_deg);
-  log_d("Wind dir: %03d", (int)ws.sensor[0].w.wind_direction_deg);
-  payload[10] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-  payload[11] = (buf[2] - '0') << 4;
-
-  if ((ws.sensor[0].s_type == SENSOR_TYPE_WEATHER1) ||
-      (ws.sensor[0].s_type == SENSOR_TYPE_POOL_THERMO) ||
-      (ws.sensor[0].s_type == SENSOR_TYPE_THERMO_HYGRO) ||
-      (ws.sensor[0].s_type == SENSOR_TYPE_SOIL))
-  {
-    if (msg_type == 0)
-    {
-      float temp_c;
-      if (ws.sensor[0].s_type == SENSOR_TYPE_SOIL)
-      {
-        temp_c = ws.sensor[0].soil.temp_c;
-      }
-      else
-      {
-        temp_c = ws.sensor[0].w.temp_c;
-      }
-      log_d("Temp: %04.1f", temp_c);
-      if (temp_c < 0)
-      {
-        temp_c += 100;
-        payload[13] = 8;
-      }
-      else
-      {
-        payload[13] = 0;
-      }
-
-      snprintf(buf, 7, "%04.1f", temp_c);
-      payload[12] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-      payload[13] |= ((buf[3] - '0') << 4) | (ws.sensor[0].battery_ok ? 2 : 0);
-      payload[16] = 0; // Flags: temp_ok
-
-      if ((ws.sensor[0].s_type == SENSOR_TYPE_WEATHER1) ||
-          (ws.sensor[0].s_type == SENSOR_TYPE_THERMO_HYGRO))
-      {
-        snprintf(buf, 7, "%02d", ws.sensor[0].w.humidity);
-        payload[14] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-      }
-
-      if (ws.sensor[0].s_type == SENSOR_TYPE_SOIL)
-      {
-        int const moisture_map[] = {0, 7, 13, 20, 27, 33, 40, 47, 53, 60, 67, 73, 80, 87, 93, 99}; // scale is 20/3
-        for (int i = 0; i < 16; i++)
-        {
-          if (moisture_map[i] > ws.sensor[0].soil.moisture)
-          {
-            log_d("Moisture: %d Index: %d", ws.sensor[0].soil.moisture, i);
-            payload[14] = i;
-            break;
-          }
-        }
-      }
-
-      if (ws.sensor[0].s_type == SENSOR_TYPE_WEATHER1)
-      {
-        msg_type = 1;
-      }
-    } // msg_type == 0
-    else
+  size_t payload_size = 0;
+  for (const EncoderInfo &e : encoder_info)
+  {
+    if (e.id == enc)
     {
-      snprintf(buf, 8, "%07.1f", ws.sensor[0].w.rain_mm);
-      log_d("Rain: %07.1f", ws.sensor[0].w.rain_mm);
-      payload[12] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-      payload[13] = ((buf[2] - '0') << 4) | (buf[3] - '0');
-      payload[14] = ((buf[4] - '0') << 4) | (buf[6] - '0');
-      payload[12] ^= 0xFF;
-      payload[13] ^= 0xFF;
-      payload[14] ^= 0xFF;
-      payload[16] = 1; // Flags: !temp_ok
-      msg_type = 0;
+      payload_size = e.size;
     }
   }
 
-  snprintf(buf, 8, "%04.1f", ws.sensor[0].w.uv);
-  log_d("UV: %04.1f", ws.sensor[0].w.uv);
-  payload[15] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-  payload[16] |= ((buf[3] - '0') << 4);
-  payload[15] ^= 0xFF;
-  payload[16] ^= 0xF0;
-
-  int sum = add_bytes(&payload[2], 15);
-  int chk = 0xFF - (sum & 0xFF);
-  log_d("Checksum: 0x%02X vs 0x%02X", chk, payload[17]);
-  payload[17] = chk;
-
-  // int crc = crc16(&payload[2], 16, 0x1021 /* polynomial */, 0 /* init */);
-  // int digest = crc ^ 0xE359;
-  //  log_d("CRC: 0x%04X", crc ^ 0xE359);
-  int digest = lfsr_digest16(&payload[2], 15, 0x8810, 0x5412);
-  payload[0] = digest >> 8;
-  payload[1] = digest & 0xFF;
-
-  memcpy(msg, payload, 18);
-
-  // Return message size
-  return 18;
+  // Message buffer: preamble (4 bytes), sync word (2 bytes) and payload
+  return airtimeUs(RADIO_OVERHEAD_BYTES + 6 + payload_size, TX_BITRATE);
 }
 
 //
-// From from rtl_433 project - https://github.com/merbanan/rtl_433/blob/master/src/devices/bresser_7in1.c (20230215)
-//
-/**
-Decoder for Bresser Weather Center 7-in-1, outdoor sensor.
-See https://github.com/merbanan/rtl_433/issues/1492
-Preamble:
-    aa aa aa aa aa 2d d4
-Observed length depends on reset_limit.
-The data has a whitening of 0xaa.
-
-Weather Center
-Data layout:
-    {271}631d05c09e9a18abaabaaaaaaaaa8adacbacff9cafcaaaaaaa000000000000000000
-    {262}10b8b4a5a3ca10aaaaaaaaaaaaaa8bcacbaaaa2aaaaaaaaaaa0000000000000000 [0.08 klx]
-    {220}543bb4a5a3ca10aaaaaaaaaaaaaa8bcacbaaaa28aaaaaaaaaa00000 [0.08 klx]
-    {273}2492b4a5a3ca10aaaaaaaaaaaaaa8bdacbaaaa2daaaaaaaaaa0000000000000000000 [0.08klx]
-    {269}9a59b4a5a3da10aaaaaaaaaaaaaa8bdac8afea28a8caaaaaaa000000000000000000 [54.0 klx UV=2.6]
-    {230}fe15b4a5a3da10aaaaaaaaaaaaaa8bdacbba382aacdaaaaaaa00000000 [109.2klx   UV=6.7]
-    {254}2544b4a5a32a10aaaaaaaaaaaaaa8bdac88aaaaabeaaaaaaaa00000000000000 [200.000 klx UV=14
-    DIGEST:8h8h ID?8h8h WDIR:8h4h 4h STYPE:4h STARTUP:1b CH:3d WGUST:8h.4h WAVG:8h.4h RAIN:8h8h4h.4h RAIN?:8h TEMP:8h.4hC FLAGS?:4h HUM:8h% LIGHT:8h4h,8h4hKL UV:8h.4h TRAILER:8h8h8h4h
-Unit of light is kLux (not W/m²).
-
-Air Quality Sensor PM2.5 / PM10 Sensor (PN 7009970)
-Data layout:
-DIGEST:8h8h ID?8h8h ?8h8h STYPE:4h STARTUP:1b CH:3b ?8h 4h ?4h8h4h PM_2_5:4h8h4h PM10:4h8h4h ?4h ?8h4h BATT:1b ?3b ?8h8h8h8h8h8h TRAILER:8h8h8h
-
-STYPE, STARTUP and CH are not covered by whitening. Probably also ID.
-First two bytes are an LFSR-16 digest, generator 0x8810 key 0xba95 with a final xor 0x6df1, which likely means we got that wrong.
-*/
-uint8_t encodeBresser7In1Payload(uint8_t *msg)
+// Transmit period in microseconds (limited to the planner's range)
+//
+uint32_t periodUs(void)
 {
-  char buf[8];
-  uint8_t payload[26] = {0};
-
-  payload[2] = (ws.sensor[0].sensor_id >> 8) & 0xFF;
-  payload[3] = (ws.sensor[0].sensor_id) & 0xFF;
-  payload[15] = (ws.sensor[0].battery_ok ? 0 : 4) ^ 0xAA;
-  payload[6] = ws.sensor[0].s_type << 4;
-  payload[6] |= (!ws.sensor[0].startup) << 3 | ws.sensor[0].chan;
-  payload[6] ^= 0xAA;
-
-  if (ws.sensor[0].s_type == SENSOR_TYPE_WEATHER1)
-  {
-    snprintf(buf, 7, "%03d", (int)ws.sensor[0].w.wind_direction_deg);
-    log_d("Wind dir: %03d", (int)ws.sensor[0].w.wind_direction_deg);
-    payload[4] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-    payload[5] = (buf[2] - '0') << 4;
-
-    // payload[6] |= (ws.sensor[0].startup ? 0 : 8) | ws.sensor[0].chan;
-
-    snprintf(buf, 7, "%04.1f", ws.sensor[0].w.wind_gust_meter_sec);
-    log_d("Wind gust: %04.1f", ws.sensor[0].w.wind_gust_meter_sec);
-    payload[7] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-    payload[8] = (buf[3] - '0') << 4;
-
-    snprintf(buf, 7, "%04.1f", ws.sensor[0].w.wind_avg_meter_sec);
-    log_d("Wind avg: %04.1f", ws.sensor[0].w.wind_avg_meter_sec);
-    payload[9] = ((buf[1] - '0') << 4) | (buf[3] - '0');
-    payload[8] |= buf[0] - '0';
-
-    snprintf(buf, 8, "%07.1f", ws.sensor[0].w.rain_mm);
-    log_d("Rain: %07.1f", ws.sensor[0].w.rain_mm);
-    payload[10] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-    payload[11] = ((buf[2] - '0') << 4) | (buf[3] - '0');
-    payload[12] = ((buf[4] - '0') << 4) | (buf[6] - '0');
-
-    float temp_c = ws.sensor[0].w.temp_c;
-    log_d("Temp: %04.1f", temp_c);
-    if (temp_c < 0)
-    {
-      temp_c += 100;
-    }
-    snprintf(buf, 7, "%04.1f", temp_c);
-    payload[14] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-    payload[15] |= ((buf[3] - '0') << 4);
-
-    snprintf(buf, 7, "%02d", ws.sensor[0].w.humidity);
-    payload[16] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-
-    snprintf(buf, 8, "%04.1f", ws.sensor[0].w.uv);
-    log_d("UV: %04.1f", ws.sensor[0].w.uv);
-    payload[20] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-    payload[21] |= ((buf[3] - '0') << 4);
+  uint64_t period = (uint64_t)tx_interval * 1000000UL;
+  return (period < UINT32_MAX) ? period : UINT32_MAX;
+}
 
-    snprintf(buf, 8, "%06d", (int)(ws.sensor[0].w.light_klx * 1000));
-    log_d("Light: %06d", (int)(ws.sensor[0].w.light_klx * 1000));
-    payload[17] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-    payload[18] = ((buf[2] - '0') << 4) | (buf[3] - '0');
-    payload[19] = ((buf[4] - '0') << 4) | (buf[5] - '0');
-  }
-  else if (ws.sensor[0].s_type == SENSOR_TYPE_AIR_PM)
-  {
-    snprintf(buf, 8, "%04d", ws.sensor[0].pm.pm_2_5);
-    log_d("PM2.5: %04d", ws.sensor[0].pm.pm_2_5);
-    payload[10] = (buf[0] - '0');
-    payload[11] = ((buf[1] - '0') << 4) | (buf[2] - '0');
-    payload[12] = ((buf[3] - '0') << 4);
+//
+// Schedule first transmission of emulated sensors [from, fleet_size)
+//
+void fleetSchedule(uint8_t from, uint32_t now)
+{
+  uint32_t interval_ms = tx_interval * 1000UL;
 
-    snprintf(buf, 8, "%04d", ws.sensor[0].pm.pm_10);
-    log_d("PM10: %04d", ws.sensor[0].pm.pm_10);
-    payload[12] = (buf[0] - '0');
-    payload[13] = ((buf[1] - '0') << 4) | (buf[2] - '0');
-    payload[14] = ((buf[3] - '0') << 4);
-  }
-  else if (ws.sensor[0].s_type == SENSOR_TYPE_CO2)
-  {
-    snprintf(buf, 8, "%04u", ws.sensor[0].co2.co2_ppm);
-    log_d("CO2: %04u", ws.sensor[0].co2.co2_ppm);
-    payload[4] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-    payload[4] = ((buf[2] - '0') << 4) | (buf[3] - '0');
-  }
-  else if (ws.sensor[0].s_type == SENSOR_TYPE_HCHO_VOC)
+  for (uint8_t i = from; i < fleet_size; i++)
   {
-    snprintf(buf, 8, "%04u", ws.sensor[0].voc.hcho_ppb);
-    log_d("HCHO: %04u", ws.sensor[0].voc.hcho_ppb);
-    payload[4] = ((buf[0] - '0') << 4) | (buf[1] - '0');
-    payload[4] = ((buf[2] - '0') << 4) | (buf[3] - '0');
-    log_d("VOC: %u", ws.sensor[0].voc.voc_level);
-    payload[22] = ws.sensor[0].voc.voc_level;
+    // Next point in time at the planned phase, relative to the start of the schedule
+    uint32_t t = fleet_epoch + fleet[i].traffic.first(interval_ms, planner.phase(i) / 1000);
+    if ((int32_t)(t - now) < 0)
+    {
+      t += ((now - t) / interval_ms + 1) * interval_ms;
+    }
+    fleet[i].next_tx = t;
   }
+}
 
-  // LFSR-16 digest, generator 0x8810 key 0xba95 final xor 0x6df1
-  // int chkdgst = (msgw[0] << 8) | msgw[1];
-  // for (int i = 2; i < 26; i++)
-  // {
-  //   payload[i] ^= 0xAA;
-  // }
-  int digest = lfsr_digest16(&payload[2], 23, 0x8810, 0xba95);
-  digest ^= 0x6df1;
-  payload[0] = digest >> 8;
-  payload[1] = digest & 0xFF;
-
-  for (int i = 0; i < 26; i++)
+//
+// (Re-)start transmit schedule of all emulated sensors
+//
+void fleetStart(uint32_t now)
+{
+  fleet_epoch = now;
+  planner.begin(periodUs(), frameAirtimeUs(encoder));
+  planner.resize(fleet_size);
+  for (uint8_t i = 0; i < fleet_size; i++)
   {
-    payload[i] ^= 0xAA;
+    fleet[i].traffic.seed(traffic_seed, i);
+    fleet[i].tx_request = TxRequest::NONE;
   }
-  // log_d("Digest: 0x%04X", digest ^ 0xAAAA ^ 0x6df1);
-
-  memcpy(msg, payload, 26);
-
-  // Return message size
-  return 26;
+  fleetSchedule(0, now);
 }
 
-/**
-Decoder for Bresser Lightning, outdoor sensor.
-
-https://github.com/merbanan/rtl_433/issues/2140
-
-DIGEST:8h8h ID:8h8h CTR:12h   ?4h8h KM:8d ?8h8h
-       0 1     2 3      4 5h   5l 6    7   8 9
-
-Preamble:
-
-  aa 2d d4
-
-Observed length depends on reset_limit.
-The data has a whitening of 0xaa.
-
-
-First two bytes are an LFSR-16 digest, generator 0x8810 key 0xabf9 with a final xor 0x899e
-*/
-uint8_t encodeBresserLightningPayload(uint8_t *msg)
+//
+// Change number of emulated sensors - the schedule of the remaining sensors is kept
+// unless the planner had to re-compute all phases
+//
+void fleetResize(uint8_t n, uint32_t now)
 {
-  uint8_t payload[10] = {0};
-  char buf[6];
-
-  payload[2] = (ws.sensor[0].sensor_id >> 8) & 0xFF;
-  payload[3] = ws.sensor[0].sensor_id & 0xFF;
+  uint8_t from = fleet_size;
 
-  // Counter encoded as BCD with most significant digit counting up to 15!
-  snprintf(buf, 6, "%04d", ws.sensor[0].lgt.strike_count);
-  log_d("count: %04d", ws.sensor[0].lgt.strike_count);
-  payload[4] = ((ws.sensor[0].lgt.strike_count / 100) << 4) | (buf[2] - '0');
-  payload[5] = (buf[3] - '0') << 4;
-
-  if (!ws.sensor[0].battery_ok)
+  fleet_size = n;
+  if (planner.resize(fleet_size))
   {
-    payload[5] |= 8;
+    from = 0;
   }
-  payload[5] ^= 0xA;
-
-  payload[6] = (SENSOR_TYPE_LIGHTNING << 4);
-
-  if (!ws.sensor[0].startup)
+  for (uint8_t i = from; i < fleet_size; i++)
   {
-    payload[6] |= 8;
+    fleet[i].traffic.seed(traffic_seed, i);
+    fleet[i].tx_request = TxRequest::NONE;
   }
-  payload[6] ^= 0xAA;
-
-  payload[7] = ws.sensor[0].lgt.distance_km;
+  fleetSchedule(from, now);
+}
 
-  payload[8] = 0;
-  payload[9] = 0;
+//
+// Formatted output to Serial
+// (Serial.printf() is not available on all cores, e.g. AVR;
+// floating point conversions are not supported by AVR's vsnprintf())
+//
+void serialPrintf(const char *fmt, ...)
+{
+  char buf[128];
+  va_list args;
 
-  int crc = crc16(&payload[2], 7, 0x1021 /* polynomial */, 0 /* init */);
-  log_d("CRC: 0x%04X", crc);
-  crc ^= 0x899e;
+  va_start(args, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  Serial.print(buf);
+}
 
-  payload[0] = ((crc >> 8) & 0xFF);
-  payload[1] = crc & 0xFF;
+//
+// Print traffic models, offered load and collision probability
+//
+void printTraffic(void)
+{
+  uint32_t airtime_us = frameAirtimeUs(encoder);
+  float load = (float)fleet_size * airtime_us / (tx_interval * 1000000.0f);
 
-  for (int i = 0; i < 10; i++)
+  for (uint8_t i = 0; i < fleet_size; i++)
   {
-    payload[i] ^= 0xAA;
+    serialPrintf("%3u: %-8s %u\n", i, traffic_names[static_cast<uint8_t>(fleet[i].traffic.type)], fleet[i].traffic.param);
   }
-
-  memcpy(msg, payload, 10);
-
-  // Return message size
-  return 10;
+  serialPrintf("Sensors: %u, seed: %lu, airtime: %lu us\n", fleet_size, (unsigned long)traffic_seed, (unsigned long)airtime_us);
+  Serial.print("Offered load: ");
+  Serial.print(load, 5);
+  Serial.print(" Erl, collision probability: ");
+  Serial.println(collisionProbability(load), 5);
 }
 
-/**
- * Decoder for Bresser Water Leakage outdoor sensor
- *
- * https://github.com/matthias-bs/BresserWeatherSensorReceiver/issues/77
- *
- * Preamble: aa aa 2d d4
- *
- * hhhh ID:hhhhhhhh TYPE:4d NSTARTUP:b CH:3d ALARM:b NALARM:b BATT:bb FLAGS:bbbb hhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhhh
- *
- * Examples:
- * ---------
- * [Bresser Water Leakage Sensor, PN 7009975]
- *
- *[00 01 02 03 04 05 06 07 08 09 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25]
- *
- * C7 70 35 97 04 08 57 70 00 00 00 00 00 00 00 00 03 FF FF FF FF FF FF FF FF FF [CH7]
- * DF 7D 36 49 27 09 56 70 00 00 00 00 00 00 00 00 03 FF FF FF FF FF FF FF FF FF [CH6]
- * 9E 30 79 84 33 06 55 70 00 00 00 00 00 00 00 00 03 FF FD DF FF BF FF DF FF FF [CH5]
- * 37 D8 57 19 73 02 51 70 00 00 00 00 00 00 00 00 03 FF FF FF FF FF BF FF EF FB [set CH4, received CH1 -> switch not positioned correctly]
- * E2 C8 68 27 91 24 54 70 00 00 00 00 00 00 00 00 03 FF FF FF FF FF FF FF FF FF [CH4]
- * B3 DA 55 57 17 40 53 70 00 00 00 00 00 00 00 00 03 FF FF FF FF FF FF FF FF FB [CH3]
- * 37 FA 84 73 03 02 52 70 00 00 00 00 00 00 00 00 03 FF FF FF DF FF FF FF FF FF [CH2]
- * 27 F3 80 02 52 88 51 70 00 00 00 00 00 00 00 00 03 FF FF FF FF FF DF FF FF FF [CH1]
- * A6 FB 80 02 52 88 59 70 00 00 00 00 00 00 00 00 03 FD F7 FF FF BF FF FF FF FF [CH1+NSTARTUP]
- * A6 FB 80 02 52 88 59 B0 00 00 00 00 00 00 00 00 03 FF FF FF FD FF F7 FF FF FF [CH1+NSTARTUP+ALARM]
- * A6 FB 80 02 52 88 59 70 00 00 00 00 00 00 00 00 03 FF FF BF F7 F7 FD 7F FF FF [CH1+NSTARTUP]
- * [Reset]
- * C0 10 36 79 37 09 51 70 00 00 00 00 00 00 00 00 01 1E FD FD FF FF FF DF FF FF [CH1]
- * C0 10 36 79 37 09 51 B0 00 00 00 00 00 00 00 00 03 FE FD FF AF FF FF FF FF FD [CH1+ALARM]
- * [Reset]
- * 71 9C 54 81 72 09 51 40 00 00 00 00 00 00 00 00 0F FF FF FF FF FF FF DF FF FE [CH1+BATT_LO]
- * 71 9C 54 81 72 09 51 40 00 00 00 00 00 00 00 00 0F FE FF FF FF FF FB FF FF FF
- * 71 9C 54 81 72 09 51 40 00 00 00 00 00 00 00 00 07 FD F7 FF DF FF FF DF FF FF
- * 71 9C 54 81 72 09 51 80 00 00 00 00 00 00 00 00 1F FF FF F7 FF FF FF FF FF FF [CH1+BATT_LO+ALARM]
- * F0 94 54 81 72 09 59 40 00 00 00 00 00 00 00 00 0F FF DF FF FF FF FF BF FD F7 [CH1+BATT_LO+NSTARTUP]
- * F0 94 54 81 72 09 59 80 00 00 00 00 00 00 00 00 03 FF B7 FF ED FF FF FF DF FF [CH1+BATT_LO+NSTARTUP+ALARM]
- *
- * - The actual message length is not known (probably 16 or 17 bytes)
- * - The first two bytes are presumably a checksum/crc/digest; algorithm still to be found
- * - The ID changes on power-up/reset
- * - NSTARTUP changes from 0 to 1 approx. one hour after power-on/reset
- */
-uint8_t encodeBresserLeakagePayload(uint8_t *msg)
+//
+// Print phase plan of emulated sensors
+//
+void printPlan(void)
 {
-  uint8_t payload[10] = {0x00};
-
-  payload[2] = ws.sensor[0].sensor_id >> 24;
-  payload[3] = (ws.sensor[0].sensor_id >> 16) & 0xFF;
-  payload[4] = (ws.sensor[0].sensor_id >> 8) & 0xFF;
-  payload[5] = (ws.sensor[0].sensor_id) & 0xFF;
-  payload[6] = ws.sensor[0].s_type << 4;
-  payload[6] |= (ws.sensor[0].startup ? 0 : 8) | ws.sensor[0].chan;
-  if (ws.sensor[0].battery_ok) {
-    payload[7] = 0x30;
-  } else {
-    payload[7] = 0x00;
-  }
-
-  if (ws.sensor[0].leak.alarm)
-  {
-    payload[7] |= 8;
-  }
-  else
+  for (uint8_t i = 0; i < planner.size(); i++)
   {
-    payload[7] |= 4;
+    uint32_t phase = planner.phase(i);
+    serialPrintf("%3u: %6lu.%03lu ms\n", i, (unsigned long)(phase / 1000), (unsigned long)(phase % 1000));
   }
-
-  uint16_t crc = crc16(&payload[2], 5, 0x1021, 0x0000);
-  log_d("CRC: 0x%04X", crc);
-
-  payload[0] = crc >> 8;
-  payload[1] = crc & 0xFF;
-
-  memcpy(msg, payload, 10);
-
-  // Return message size
-  return 10;
+  serialPrintf("Sensors: %u, airtime: %lu us, min. gap: %lu us, worst-case lag: %lu us\n",
+               planner.size(), (unsigned long)planner.airtime(), (unsigned long)planner.minGap(), (unsigned long)planner.worstLag());
 }
 
-void loop()
+//
+// Plan fleet of n sensors with current interval and encoder (incrementally)
+// and print worst-case lag for selected fleet sizes
+//
+void printPlanSweep(uint16_t n)
 {
-  String input_str;
-  static String json_str;
-  static Encoders encoder = Encoders::ENC_BRESSER_6IN1;
-  static unsigned tx_interval = TX_INTERVAL;
-
-  if (Serial.available())
-  {
-    input_str = Serial.readStringUntil('\n');
-  }
+  static const uint16_t sizes[] = {10, 20, 50, 100, 200, 500};
+  SlotPlanner<MAX_PLAN_SIZE> *p = new (std::nothrow) SlotPlanner<MAX_PLAN_SIZE>;
 
-  if (input_str.startsWith("{"))
+  if (!p)
   {
-    json_str = input_str;
-    log_i("JSON String: %s", json_str.c_str());
+    log_e("Out of memory!");
+    return;
   }
-  else if (input_str.startsWith("enc"))
+  p->begin(periodUs(), frameAirtimeUs(encoder));
+  serialPrintf("Interval: %u s, airtime: %lu us\n", tx_interval, (unsigned long)p->airtime());
+  for (uint16_t i = 1; i <= n; i++)
   {
-    if (int pos = input_str.indexOf('='))
+    p->add();
+    bool print = (i == n);
+    for (uint16_t s : sizes)
     {
-      input_str.toLowerCase();
-      if (input_str.substring(pos + 1).startsWith("bresser-5in1"))
-      {
-        encoder = Encoders::ENC_BRESSER_5IN1;
-        log_i("Encoder: Bresser 5-in-1");
-      }
-      else if (input_str.substring(pos + 1).startsWith("bresser-6in1"))
-      {
-        encoder = Encoders::ENC_BRESSER_6IN1;
-        log_i("Encoder: Bresser 6-in-1");
-      }
-      else if (input_str.substring(pos + 1).startsWith("bresser-7in1"))
-      {
-        encoder = Encoders::ENC_BRESSER_7IN1;
-        log_i("Encoder: Bresser 7-in-1");
-      }
-      else if (input_str.substring(pos + 1).startsWith("bresser-lightning"))
-      {
-        encoder = Encoders::ENC_BRESSER_LIGHTNING;
-        log_i("Encoder: Bresser Lightning");
-      }
-      else if (input_str.substring(pos + 1).startsWith("bresser-leakage"))
+      print |= (i == s);
+    }
+    if (print)
+    {
+      uint32_t lag = p->worstLag();
+      if (lag == SlotPlanner<MAX_PLAN_SIZE>::SATURATED)
       {
-        encoder = Encoders::ENC_BRESSER_LEAKAGE;
-        log_i("Encoder: Bresser Leakage");
-        log_w("This encoder can currently only send raw data!");
+        serialPrintf("%3u sensors: min. gap: %8lu us, worst-case lag: saturated\n", i, (unsigned long)p->minGap());
       }
       else
       {
-        log_w("Unknown encoder!");
-      }
-    }
-  } // "enc[oder]"
-  else if (input_str.startsWith("int"))
-  {
-    if (int pos = input_str.indexOf('='))
-    {
-      int val = input_str.substring(pos + 1).toInt();
-      if (val > 10)
-      {
-        tx_interval = val;
-        log_i("tx_interval: %d s", tx_interval);
+        serialPrintf("%3u sensors: min. gap: %8lu us, worst-case lag: %lu us\n", i, (unsigned long)p->minGap(), (unsigned long)lag);
       }
     }
+  }
+  delete p;
+}
+
+//
+// Set traffic model - traffic=<type>[,<param>[,<index>]]
+//
+void setTraffic(const char *val)
+{
+  int8_t type = -1;
+  for (uint8_t i = 0; i < sizeof(traffic_names) / sizeof(traffic_names[0]); i++)
+  {
+    if (strncasecmp(val, traffic_names[i], strlen(traffic_names[i])) == 0)
+    {
+      type = i;
+      break;
+    }
+  }
+  if (type < 0)
+  {
+    log_w("Unknown traffic model!");
+    return;
+  }
+
+  const char *arg = strchr(val, ',');
+  uint16_t param = arg ? atoi(arg + 1) : 0;
+  arg = arg ? strchr(arg + 1, ',') : nullptr;
+
+  uint8_t first = 0;
+  uint8_t last = MAX_FLEET_SIZE - 1;
+  if (arg)
+  {
+    first = last = atoi(arg + 1);
+    if (first >= MAX_FLEET_SIZE)
+    {
+      log_w("Invalid sensor index!");
+      return;
+    }
+  }
+  for (uint8_t i = first; i <= last; i++)
+  {
+    fleet[i].traffic.type = static_cast<Traffic>(type);
+    fleet[i].traffic.param = param;
+  }
+  log_i("Traffic: %s, param: %u", traffic_names[type], param);
+}
+
+#if defined(FLEET_IMAGE)
+typedef FleetImage<SensorRecord, MAX_FLEET_SIZE, MAX_LINE_LENGTH + 1> FleetConfig;
+
+//
+// Save fleet configuration to flash
+//
+void configSave(void)
+{
+  FleetConfig *img = new (std::nothrow) FleetConfig;
+  if (!img)
+  {
+    log_e("Config: Out of memory!");
+    return;
+  }
+  uint32_t t_start = micros();
+  img->tx_interval = tx_interval;
+  img->traffic_seed = traffic_seed;
+  img->encoder = static_cast<uint8_t>(encoder);
+  img->fleet_size = fleet_size;
+  img->tx_on_input = tx_on_input;
+  for (uint8_t i = 0; i < MAX_FLEET_SIZE; i++)
+  {
+    img->slot[i].sensor = sensor_data[i];
+    img->slot[i].traffic_param = fleet[i].traffic.param;
+    img->slot[i].traffic = static_cast<uint8_t>(fleet[i].traffic.type);
+    img->slot[i].encoder = static_cast<uint8_t>(fleet[i].encoder);
+    img->slot[i].own_data = fleet[i].own_data;
+  }
+  img->json_sensor = json_sensor;
+  size_t size = img->seal(json_str.c_str(), json_str.length());
+
+  File file = LittleFS.open(FLEET_IMAGE, "w");
+  size_t written = file ? file.write(reinterpret_cast<const uint8_t *>(img), size) : 0;
+  if (file)
+  {
+    file.close();
+  }
+  delete img;
+  if (written != size)
+  {
+    log_e("Config: Writing %s failed!", FLEET_IMAGE);
+    return;
+  }
+  log_i("Config: %u bytes saved in %lu us", (unsigned)size, (unsigned long)(micros() - t_start));
+}
+
+//
+// Load fleet configuration from flash - single read, no parsing
+// The configuration is only applied if the image is valid.
+//
+bool configLoad(void)
+{
+  if (!LittleFS.exists(FLEET_IMAGE))
+  {
+    log_i("Config: No saved configuration");
+    return false;
+  }
+  FleetConfig *img = new (std::nothrow) FleetConfig;
+  if (!img)
+  {
+    log_e("Config: Out of memory!");
+    return false;
+  }
+  uint32_t t_start = micros();
+  File file = LittleFS.open(FLEET_IMAGE, "r");
+  size_t len = file ? file.read(reinterpret_cast<uint8_t *>(img), sizeof(FleetConfig)) : 0;
+  if (file)
+  {
+    file.close();
+  }
+
+  bool valid = img->check(len) &&
+               img->encoder < sizeof(encoder_info) / sizeof(encoder_info[0]) &&
+               img->fleet_size >= 1 && img->fleet_size <= MAX_FLEET_SIZE;
+  for (uint8_t i = 0; i < MAX_FLEET_SIZE && valid; i++)
+  {
+    valid = img->slot[i].traffic < sizeof(traffic_names) / sizeof(traffic_names[0]) &&
+            img->slot[i].encoder < sizeof(encoder_info) / sizeof(encoder_info[0]);
+  }
+  if (!valid)
+  {
+    delete img;
+    log_w("Config: Invalid image %s (%u bytes)!", FLEET_IMAGE, (unsigned)len);
+    return false;
+  }
+
+  tx_interval = img->tx_interval;
+  traffic_seed = img->traffic_seed;
+  encoder = static_cast<Encoders>(img->encoder);
+  fleet_size = img->fleet_size;
+  tx_on_input = img->tx_on_input;
+  for (uint8_t i = 0; i < MAX_FLEET_SIZE; i++)
+  {
+    sensor_data[i] = img->slot[i].sensor;
+    fleet[i].traffic.param = img->slot[i].traffic_param;
+    fleet[i].traffic.type = static_cast<Traffic>(img->slot[i].traffic);
+    fleet[i].encoder = static_cast<Encoders>(img->slot[i].encoder);
+    fleet[i].own_data = img->slot[i].own_data;
+    fleet[i].updated = false;
+    fleet[i].dirty = true;
+  }
+  json_sensor = img->json_sensor;
+  json_str = img->json;
+  delete img;
+  fleet_restart = true;
+
+  uint32_t t_us = micros() - t_start;
+  log_i("Config: %u bytes loaded in %lu us (%u sensors, encoder %s)", (unsigned)len, (unsigned long)t_us,
+        fleet_size, encoder_info[static_cast<uint8_t>(encoder)].name);
+  return true;
+}
+#endif
+
+#if defined(DATA_JSON_INPUT) || defined(DATA_JSON_CONST)
+//
+// Find emulated sensor with own data by ID
+//
+int findSensor(uint32_t id)
+{
+  for (uint8_t i = 0; i < MAX_FLEET_SIZE; i++)
+  {
+    if (fleet[i].own_data && sensor_data[i].sensor_id == id)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+//
+// Copy batch update entry to the emulated sensor with the same ID
+// (or to the next sensor without own data)
+//
+bool updateSensor(JsonVariantConst entry, uint32_t id)
+{
+  Encoders enc = encoder;
+  const char *name = entry["encoder"].as<const char *>();
+  if (name)
+  {
+    const EncoderInfo *info = findEncoder(name);
+    if (!info)
+    {
+      log_w("Sensor %08lX: Unknown encoder %s!", (unsigned long)id, name);
+      return false;
+    }
+    enc = info->id;
+  }
+
+  int slot = findSensor(id);
+  if (slot < 0)
+  {
+    // New sensor
+    for (uint8_t i = 0; i < MAX_FLEET_SIZE && slot < 0; i++)
+    {
+      if (!fleet[i].own_data)
+      {
+        slot = i;
+      }
+    }
+    if (slot < 0)
+    {
+      log_w("Sensor %08lX: No free slot (max. %d sensors)!", (unsigned long)id, MAX_FLEET_SIZE);
+      return false;
+    }
+  }
+  if (!fleet[slot].own_data || fleet[slot].encoder != enc)
+  {
+    // New sensor or encoder changed - no previous data
+    sensor_data[slot] = SensorRecord();
+  }
+  if (!jsonSensor(enc, entry, sensor_data[slot]))
+  {
+    return false;
+  }
+  sensor_data[slot].sensor_id = id;
+  fleet[slot].encoder = enc;
+  fleet[slot].own_data = true;
+  fleet[slot].updated = true;
+  fleet[slot].dirty = true;
+  if (slot >= fleet_size)
+  {
+    fleetResize(slot + 1, millis());
+  }
+  return true;
+}
+
+//
+// Batch update - JSON array of sensor objects or object keyed by sensor ID
+// (see JsonFilter.h), parsed in one pass
+//
+void handleBatch(const char *json, JsonForm form)
+{
+  // Filter - all keys of the entries (encoder per entry)
+  static JsonDocument filter;
+  static JsonForm filter_form = JsonForm::SINGLE;
+
+  uint32_t t_start = micros();
+  if (form != filter_form)
+  {
+    filter.clear();
+    if (form == JsonForm::ARRAY)
+    {
+      jsonFilterKeys(filter.add<JsonObject>(), JSON_KEYS_BATCH);
+    }
+    else
+    {
+      jsonFilterKeys(filter["*"].to<JsonObject>(), JSON_KEYS_BATCH);
+    }
+    filter_form = form;
+  }
+
+  JsonDocument doc;
+  DeserializationError error = deserializeJson(doc, json, DeserializationOption::Filter(filter));
+  if (error)
+  {
+    log_e("DeserializeJson() failed: %s", error.f_str());
+    return;
+  }
+
+  unsigned entries = 0;
+  unsigned updated = 0;
+  if (form == JsonForm::ARRAY)
+  {
+    for (JsonVariantConst entry : doc.as<JsonArrayConst>())
+    {
+      entries++;
+      updated += updateSensor(entry, entry["sensor_id"]);
+    }
+  }
+  else
+  {
+    for (JsonPairConst kv : doc.as<JsonObjectConst>())
+    {
+      entries++;
+      updated += updateSensor(kv.value(), strtoul(kv.key().c_str(), nullptr, 0));
+    }
+  }
+  uint32_t t_us = micros() - t_start;
+
+  // Max. update rate - serial transfer (10 bits per character) and processing
+  size_t len = strlen(json) + 1;
+  log_i("Batch: %u/%u sensors updated, %u bytes, %lu us", updated, entries, (unsigned)len, (unsigned long)t_us);
+  if (updated)
+  {
+    static const uint32_t bauds[] = {115200, 921600};
+    for (uint32_t baud : bauds)
+    {
+      float t = len * 10.0f / baud + t_us / 1e6f;
+      log_i("  %6lu baud: %.0f updates/s", (unsigned long)baud, updated / t);
+    }
+  }
+}
+#endif
+
+#if defined(DATA_JSON_INPUT) || defined(DATA_JSON_CONST)
+//
+// Set single field of emulated sensor - 'set <id> <field>=<value>'
+// A sensor derived from the JSON string gets its own data.
+//
+void setCommand(const char *cmd)
+{
+  uint32_t t_start = micros();
+  const char *arg = cmd + 4;
+  char *end;
+  uint32_t id = strtoul(arg, &end, 0);
+  const char *field = end + 1;
+  const char *val = (end != arg && *end == ' ') ? strchr(field, '=') : nullptr;
+  if (!val)
+  {
+    log_w("Usage: set <id> <field>=<value>");
+    return;
+  }
+  int key = fieldIndex(field, val - field);
+  val++;
+  if (key < 0)
+  {
+    log_w("Unknown field!");
+    return;
+  }
+
+  int slot = findSensor(id);
+  for (uint8_t i = 0; i < fleet_size && slot < 0; i++)
+  {
+    if (sensor_data[i].sensor_id == id)
+    {
+      slot = i;
+      fleet[i].encoder = encoder;
+      fleet[i].own_data = true;
+    }
+  }
+  if (slot < 0)
+  {
+    log_w("Sensor %08lX not found!", (unsigned long)id);
+    return;
+  }
+
+  if (key == JK_ENCODER)
+  {
+    const EncoderInfo *info = findEncoder(val);
+    if (!info)
+    {
+      log_w("Unknown encoder!");
+      return;
+    }
+    fleet[slot].encoder = info->id;
+  }
+  else
+  {
+    setField(sensor_data[slot], key, strtod(val, nullptr));
+  }
+  fleet[slot].dirty = true;
+  fleet[slot].updated = true;
+  log_i("Sensor %08lX: %s=%s (%u bytes, %lu us)", (unsigned long)id, json_keys[key], val,
+        (unsigned)strlen(cmd) + 1, (unsigned long)(micros() - t_start));
+}
+#endif
+
+//
+// Apply JSON update - single sensor (sensor 0) or batch
+//
+void setJson(const char *json)
+{
+  JsonForm form = jsonForm(json);
+  if (form == JsonForm::SINGLE)
+  {
+    json_str = json;
+    fleet[0].own_data = false;
+    fleet[0].updated = true;
+    log_i("JSON String: %s", json_str.c_str());
+  }
+  else
+  {
+#if defined(DATA_JSON_INPUT) || defined(DATA_JSON_CONST)
+    handleBatch(json, form);
+#else
+    log_w("Batch updates require JSON data!");
+#endif
+  }
+}
+
+//
+// Select encoder of sensor 0
+//
+void setEncoder(const EncoderInfo *info)
+{
+  encoder = info->id;
+  json_sensor = SensorRecord();
+  log_i("Encoder: %s", info->name);
+  if (planner.setAirtime(frameAirtimeUs(encoder)))
+  {
+    fleetSchedule(0, millis());
+  }
+}
+
+//
+// Set transmit interval in s (> 10)
+//
+void setInterval(int interval)
+{
+  if (interval > 10)
+  {
+    tx_interval = interval;
+    log_i("tx_interval: %d s", tx_interval);
+    fleet_restart = true;
+  }
+}
+
+//
+// Execute serial console command
+//
+void handleCommand(const char *cmd)
+{
+  const char *val = strchr(cmd, '=');
+
+  if (cmd[0] == '{' || cmd[0] == '[')
+  {
+    setJson(cmd);
+  }
+  else if (strncmp(cmd, "enc", 3) == 0)
+  {
+    if (val)
+    {
+      const EncoderInfo *info = findEncoder(val + 1);
+      if (info)
+      {
+        setEncoder(info);
+      }
+      else
+      {
+        log_w("Unknown encoder!");
+      }
+    }
+  } // "enc[oder]"
+  else if (strncmp(cmd, "int", 3) == 0)
+  {
+    if (val)
+    {
+      setInterval(atoi(val + 1));
+    }
   } // "int[erval]"
-  else if (input_str != "")
+  else if (strncmp(cmd, "fleet", 5) == 0)
+  {
+    if (val)
+    {
+      int n = atoi(val + 1);
+      if (n >= 1 && n <= MAX_FLEET_SIZE)
+      {
+        fleetResize(n, millis());
+        log_i("Sensors: %d", fleet_size);
+      }
+      else
+      {
+        log_w("Number of sensors must be 1...%d!", MAX_FLEET_SIZE);
+      }
+    }
+  } // "fleet"
+  else if (strncmp(cmd, "traffic", 7) == 0)
+  {
+    if (val)
+    {
+      setTraffic(val + 1);
+      fleet_restart = true;
+    }
+    else
+    {
+      printTraffic();
+    }
+  } // "traffic"
+  else if (strncmp(cmd, "set ", 4) == 0)
+  {
+#if defined(DATA_JSON_INPUT) || defined(DATA_JSON_CONST)
+    setCommand(cmd);
+#else
+    log_w("Setting fields requires JSON data!");
+#endif
+  } // "set"
+  else if (strncmp(cmd, "seed", 4) == 0)
+  {
+    if (val)
+    {
+      traffic_seed = strtoul(val + 1, nullptr, 0);
+      log_i("Seed: %lu", (unsigned long)traffic_seed);
+      fleet_restart = true;
+    }
+  } // "seed"
+  else if (strncmp(cmd, "plan", 4) == 0)
+  {
+    if (val)
+    {
+      int n = atoi(val + 1);
+      if (n >= 1 && n <= MAX_PLAN_SIZE)
+      {
+        printPlanSweep(n);
+      }
+      else
+      {
+        log_w("Number of sensors must be 1...%d!", MAX_PLAN_SIZE);
+      }
+    }
+    else
+    {
+      printPlan();
+    }
+  } // "plan"
+  else if (strncmp(cmd, "trigger", 7) == 0)
+  {
+    if (val && strcmp(val + 1, "input") == 0)
+    {
+      tx_on_input = true;
+    }
+    else if (val && strcmp(val + 1, "timer") == 0)
+    {
+      tx_on_input = false;
+      fleet_restart = true;
+    }
+    log_i("Trigger: %s", tx_on_input ? "input" : "timer");
+  } // "trigger"
+  else if (strncmp(cmd, "stats", 5) == 0)
+  {
+    if (val && strcmp(val + 1, "json") == 0)
+    {
+      stats_request = StatsFormat::JSON;
+    }
+    else if (val && strcmp(val + 1, "reset") == 0)
+    {
+      tx_stats.reset();
+      log_i("Statistics reset");
+    }
+    else
+    {
+      stats_request = StatsFormat::TEXT;
+    }
+  } // "stats"
+  else if (strncmp(cmd, "config", 6) == 0)
+  {
+#if defined(FLEET_IMAGE)
+    if (val && strcmp(val + 1, "save") == 0)
+    {
+      configSave();
+    }
+    else if (val && strcmp(val + 1, "load") == 0)
+    {
+      configLoad();
+    }
+    else if (val && strcmp(val + 1, "erase") == 0)
+    {
+      LittleFS.remove(FLEET_IMAGE);
+      log_i("Config: Erased");
+    }
+    else
+    {
+      log_w("Usage: config=save|load|erase");
+    }
+#else
+    log_w("Persistent configuration not enabled (FLEET_IMAGE)!");
+#endif
+  } // "config"
+  else if (strncmp(cmd, "probes", 6) == 0)
+  {
+#if defined(STAGE_PROBES)
+    if (val && strcmp(val + 1, "reset") == 0)
+    {
+      stage_probes.reset();
+      log_i("Stage probes reset");
+    }
+    else
+    {
+      probes_request = true;
+    }
+#else
+    log_w("Stage probes not enabled (STAGE_PROBES)!");
+#endif
+  } // "probes"
+  else if (cmd[0] != '\0')
   {
     log_w("Unknown command!");
   }
+}
 
-  uint8_t msg_buf[40];
-  uint8_t msg_size;
+//
+// Encode message of emulated sensor into tx_frame
+//
+void encodeFrame(uint8_t slot)
+{
+  FrameWriter frame(tx_frame.data, sizeof(tx_frame.data));
   bool valid = true;
+  Encoders enc = fleet[slot].own_data ? fleet[slot].encoder : encoder;
 
-  msg_size = msgBegin(msg_buf);
+  msgBegin(frame);
 
 #if defined(DATA_RAW)
-  msg_size += rawPayload(encoder, &msg_buf[msg_size]);
+  rawPayload(enc, frame);
 #elif defined(DATA_GEN)
-  genData(encoder);
+  uint32_t t_gen = micros();
+  genData(enc, slot);
+  tx_stats.gen_us.add(micros() - t_gen);
 #elif defined(DATA_JSON_CONST)
-  genJson(encoder, json_str);
+  genJson(enc, json_str);
 #endif
 
 #if defined(DATA_JSON_CONST) || defined(DATA_JSON_INPUT)
-  if (json_str.length() > 0)
+  if (fleet[slot].own_data)
   {
-    valid = deSerialize(encoder, json_str);
+    // Sensor data from batch update
+  }
+  else if (json_str.length() > 0)
+  {
+    PROBE_BEGIN(DESERIALIZE);
+    valid = deSerialize(enc, json_str.c_str(), json_sensor);
+    PROBE_END(DESERIALIZE);
+
+    // The data source provides one sensor; derive the other sensors from it
+    sensor_data[slot] = json_sensor;
+    sensor_data[slot].sensor_id += slot;
   }
   else
   {
@@ -1079,44 +1382,74 @@ void loop()
 #endif
 
 #if !defined(DATA_RAW)
-  if (valid)
+  const EncoderInfo *info = nullptr;
+  for (const EncoderInfo &e : encoder_info)
   {
-    switch (encoder)
+    if (e.id == enc)
     {
-    case Encoders::ENC_BRESSER_5IN1:
-      msg_size += encodeBresser5In1Payload(&msg_buf[msg_size]);
-      break;
-
-    case Encoders::ENC_BRESSER_6IN1:
-      msg_size += encodeBresser6In1Payload(&msg_buf[msg_size]);
-      break;
-
-    case Encoders::ENC_BRESSER_7IN1:
-      msg_size += encodeBresser7In1Payload(&msg_buf[msg_size]);
-      break;
-
-    case Encoders::ENC_BRESSER_LIGHTNING:
-      msg_size += encodeBresserLightningPayload(&msg_buf[msg_size]);
+      info = &e;
       break;
+    }
+  }
 
-    case Encoders::ENC_BRESSER_LEAKAGE:
-      msg_size += encodeBresserLeakagePayload(&msg_buf[msg_size]);
-      break;
+  if (valid && info)
+  {
+    uint32_t t_encode = micros();
+    PROBE_BEGIN(ENCODE);
+    size_t payload_start = frame.size();
+    bool cached = fleet[slot].own_data && enc != Encoders::ENC_BRESSER_6IN1;
+    if (fleet[slot].dirty || !fleet[slot].own_data)
+    {
+      // Sensor data changed - data of sensors without own data is set before each transmission
+      frames_6in1[slot].invalidate();
+    }
+    if (cached && !fleet[slot].dirty)
+    {
+      // Data unchanged - payload from cache
+      frame.write(payload_cache[slot], info->size);
+    }
+    else
+    {
+      info->encode(frame, slot);
 
-    default:
-      log_e("Encoder not implemented!");
-      msg_size = 0;
+      if (info->whitening)
+      {
+        whiten(&frame.data()[payload_start], frame.size() - payload_start, info->whitening);
+      }
+      if (cached)
+      {
+        memcpy(payload_cache[slot], &frame.data()[payload_start], info->size);
+      }
+      fleet[slot].dirty = false;
     }
+    PROBE_END(ENCODE);
+    tx_stats.encode_us.add(micros() - t_encode);
   }
   else
   {
-    msg_size = 0;
+    if (!info)
+    {
+      log_e("Encoder not implemented!");
+    }
+    frame.clear();
   }
 #endif
 
-  log_i("%s Transmitting packet (%d bytes)... ", TRANSCEIVER_CHIP, msg_size);
-  int state = radio.transmit(msg_buf, msg_size);
+  tx_frame.size = frame.size();
+  tx_frame.enc = enc;
+  tx_frame.ready = true;
+}
+
+//
+// Update statistics and log result of transmission
+//
+void txResult(Encoders enc, uint8_t size, int state, uint32_t tx_us)
+{
+  tx_stats.tx_us.add(tx_us);
+  tx_stats.txResult(static_cast<uint8_t>(enc), state);
+  tx_stats.heapFree();
 
+  PROBE_BEGIN(LOG);
   if (state == RADIOLIB_ERR_NONE)
   {
     // the packet was successfully transmitted
@@ -1124,7 +1457,7 @@ void loop()
 
 #if defined(USE_SX1276)
     // print measured data rate
-    log_i("%s Datarate:\t%f bps", TRANSCEIVER_CHIP, radio.getDataRate());
+    log_i("%s Datarate:\t%f bps", TRANSCEIVER_CHIP, tx_us ? size * 8 * 1e6f / tx_us : 0.0f);
 #endif
   }
   else if (state == RADIOLIB_ERR_PACKET_TOO_LONG)
@@ -1142,73 +1475,390 @@ void loop()
     // some other error occurred
     log_e("failed, code %d", state);
   }
+  PROBE_END(LOG);
+}
+
+//
+// Print statistics as text
+//
+void printStats(void)
+{
+  uint32_t heap_free = tx_stats.heapFree();
+
+  serialPrintf("Frames sent:\n");
+  for (const EncoderInfo &e : encoder_info)
+  {
+    serialPrintf("  %-20s %lu\n", e.name, (unsigned long)tx_stats.frames[static_cast<uint8_t>(e.id)]);
+  }
+  serialPrintf("TX errors:\n");
+  serialPrintf("  %-20s %lu\n", "too long", (unsigned long)tx_stats.err_too_long);
+  serialPrintf("  %-20s %lu\n", "timeout", (unsigned long)tx_stats.err_timeout);
+  serialPrintf("  %-20s %lu\n", "other", (unsigned long)tx_stats.err_other);
+  for (uint8_t i = 0; i < TxStats::MAX_ERR_CODES; i++)
+  {
+    if (tx_stats.err_codes[i].count)
+    {
+      serialPrintf("    code %-15d %lu\n", tx_stats.err_codes[i].code, (unsigned long)tx_stats.err_codes[i].count);
+    }
+  }
+
+  const struct {
+    const char *name;
+    const Log2Histogram &hist;
+  } histograms[] = {
+    {"Data generation time [us]", tx_stats.gen_us},
+    {"Encode time [us]", tx_stats.encode_us},
+    {"TX time [us]", tx_stats.tx_us},
+    {"Scheduling lag [ms]", tx_stats.lag_ms}
+  };
+  for (const auto &h : histograms)
+  {
+    serialPrintf("%s (max. %lu):\n", h.name, (unsigned long)h.hist.max());
+    for (uint8_t i = 0; i < Log2Histogram::NUM_BUCKETS; i++)
+    {
+      if (h.hist.count(i))
+      {
+        serialPrintf("  >= %-17lu %lu\n", (unsigned long)Log2Histogram::lowerBound(i), (unsigned long)h.hist.count(i));
+      }
+    }
+  }
+  serialPrintf("Heap free/min: %lu/%lu bytes\n", (unsigned long)heap_free, (unsigned long)tx_stats.heap_min);
+}
+
+//
+// Print statistics as single line JSON object
+//
+void printStatsJson(void)
+{
+  uint32_t heap_free = tx_stats.heapFree();
+  bool first = true;
+
+  serialPrintf("{\"frames\":{");
+  for (const EncoderInfo &e : encoder_info)
+  {
+    serialPrintf("%s\"%s\":%lu", first ? "" : ",", e.name, (unsigned long)tx_stats.frames[static_cast<uint8_t>(e.id)]);
+    first = false;
+  }
+  serialPrintf("},\"tx_err\":{\"too_long\":%lu,\"timeout\":%lu,\"other\":%lu,\"codes\":{",
+               (unsigned long)tx_stats.err_too_long, (unsigned long)tx_stats.err_timeout, (unsigned long)tx_stats.err_other);
+  first = true;
+  for (uint8_t i = 0; i < TxStats::MAX_ERR_CODES; i++)
+  {
+    if (tx_stats.err_codes[i].count)
+    {
+      serialPrintf("%s\"%d\":%lu", first ? "" : ",", tx_stats.err_codes[i].code, (unsigned long)tx_stats.err_codes[i].count);
+      first = false;
+    }
+  }
+  serialPrintf("}}");
+
+  const struct {
+    const char *name;
+    const Log2Histogram &hist;
+  } histograms[] = {
+    {"gen_us", tx_stats.gen_us},
+    {"encode_us", tx_stats.encode_us},
+    {"tx_us", tx_stats.tx_us},
+    {"lag_ms", tx_stats.lag_ms}
+  };
+  for (const auto &h : histograms)
+  {
+    serialPrintf(",\"%s\":{\"max\":%lu,\"hist\":[", h.name, (unsigned long)h.hist.max());
+    for (uint8_t i = 0; i < Log2Histogram::NUM_BUCKETS; i++)
+    {
+      serialPrintf("%s%lu", i ? "," : "", (unsigned long)h.hist.count(i));
+    }
+    serialPrintf("]}");
+  }
+  serialPrintf(",\"heap_free\":%lu,\"heap_min\":%lu}\n", (unsigned long)heap_free, (unsigned long)tx_stats.heap_min);
+}
+
+//
+// Print statistics and stage probes if requested
+//
+void printStatsRequest(void)
+{
+  if (stats_request == StatsFormat::TEXT)
+  {
+    printStats();
+  }
+  else if (stats_request == StatsFormat::JSON)
+  {
+    printStatsJson();
+  }
+  stats_request = StatsFormat::NONE;
 
-  // wait for TX_INTERVAL seconds before transmitting again
-  delay(tx_interval * 1000);
+#if defined(STAGE_PROBES)
+  if (probes_request)
+  {
+    stage_probes.print(Serial);
+    probes_request = false;
+  }
+#endif
 }
 
 //
-// From from rtl_433 project - https://github.com/merbanan/rtl_433/blob/master/src/util.c
+// Apply command from the command queue
 //
-int add_bytes(uint8_t const message[], unsigned num_bytes)
+void applyCommand(const Command &c)
 {
-  int result = 0;
-  for (unsigned i = 0; i < num_bytes; ++i)
+  switch (c.type)
   {
-    result += message[i];
+  case CommandType::JSON:
+    if (c.json)
+    {
+      setJson(c.json);
+      delete[] c.json;
+    }
+    break;
+  case CommandType::ENCODER:
+    if (c.arg < sizeof(encoder_info) / sizeof(encoder_info[0]))
+    {
+      setEncoder(&encoder_info[c.arg]);
+    }
+    break;
+  case CommandType::INTERVAL:
+    setInterval(c.value);
+    break;
+  case CommandType::STATS:
+    stats_request = static_cast<StatsFormat>(c.arg);
+    break;
+  }
+
+  uint32_t dropped = command_queue.dropped();
+  if (dropped != command_queue_dropped)
+  {
+    log_w("Command queue full - %lu commands dropped", (unsigned long)dropped);
+    command_queue_dropped = dropped;
   }
-  return result;
 }
 
 //
-// From from rtl_433 project - https://github.com/merbanan/rtl_433/blob/master/src/util.c
+// Sensor with the earliest requested transmission (UINT8_MAX if none)
 //
-uint16_t lfsr_digest16(uint8_t const message[], unsigned bytes, uint16_t gen, uint16_t key)
+uint8_t nextTxRequest(void)
 {
-  uint16_t sum = 0;
-  for (unsigned k = 0; k < bytes; ++k)
+  uint8_t slot = UINT8_MAX;
+  for (uint8_t i = 0; i < fleet_size; i++)
   {
-    uint8_t data = message[k];
-    for (int i = 7; i >= 0; --i)
+    if (fleet[i].tx_request != TxRequest::NONE &&
+        (slot == UINT8_MAX || (int32_t)(fleet[i].tx_due - fleet[slot].tx_due) < 0))
     {
-      // fprintf(stderr, "key at bit %d : %04x\n", i, key);
-      // if data bit is set then xor with key
-      if ((data >> i) & 1)
-        sum ^= key;
-
-      // roll the key right (actually the lsb is dropped here)
-      // and apply the gen (needs to include the dropped lsb as msb)
-      if (key & 1)
-        key = (key >> 1) ^ gen;
-      else
-        key = (key >> 1);
+      slot = i;
     }
   }
-  return sum;
+  return slot;
 }
 
 //
-// From from rtl_433 project - https://github.com/merbanan/rtl_433/blob/master/src/util.c
+// Packet sent interrupt
 //
-uint16_t crc16(uint8_t const message[], unsigned nBytes, uint16_t polynomial, uint16_t init)
+void IRAM_ATTR txDoneIsr(void)
 {
-  uint16_t remainder = init;
-  unsigned byte, bit;
+  tx_done.set();
+}
 
-  for (byte = 0; byte < nBytes; ++byte)
+//
+// Input reader - serial console lines and commands from the command queue
+//
+class InputTask : public Task {
+public:
+  void run(uint32_t now) override
   {
-    remainder ^= message[byte] << 8;
-    for (bit = 0; bit < 8; ++bit)
+    TASK_BEGIN();
+    for (;;)
     {
-      if (remainder & 0x8000)
+      if (fleet_restart && !tx_on_input)
       {
-        remainder = (remainder << 1) ^ polynomial;
+        fleetStart(now);
+        fleet_restart = false;
+      }
+
+      // Process complete input lines - does not wait for further input
+      TASK_WAIT_UNTIL((_line = line_reader.poll(Serial)) != nullptr || command_queue.pop(_cmd));
+      if (_line)
+      {
+        PROBE_BEGIN(PARSE);
+        handleCommand(_line);
+        PROBE_END(PARSE);
+        log_d("Input-to-apply latency: %lu us", (unsigned long)(micros() - line_reader.lineStart()));
       }
       else
       {
-        remainder = (remainder << 1);
+        applyCommand(_cmd);
       }
+
+      // Replay - the sensors updated by the input are transmitted before
+      // the next input is processed
+      for (uint8_t i = 0; i < fleet_size; i++)
+      {
+        if (fleet[i].updated)
+        {
+          fleet[i].updated = false;
+          if (tx_on_input)
+          {
+            fleet[i].tx_request = TxRequest::INPUT;
+            fleet[i].tx_due = now;
+          }
+        }
+      }
+      TASK_WAIT_UNTIL(!tx_on_input || txIdle());
     }
+    TASK_END();
   }
-  return remainder;
+
+private:
+  const char *_line; // valid until next poll
+  Command _cmd;
+};
+
+//
+// Emulated sensor - requests a transmission when it is due according to its traffic model
+//
+class SensorTask : public Task {
+public:
+  uint8_t slot;
+
+  void run(uint32_t now) override
+  {
+    TASK_BEGIN();
+    for (;;)
+    {
+      // The schedule may be changed by input (fleetSchedule()) while waiting
+      TASK_WAIT_UNTIL(!tx_on_input && slot < fleet_size && fleet[slot].tx_request == TxRequest::NONE &&
+                      (int32_t)(now - fleet[slot].next_tx) >= 0);
+      fleet[slot].tx_request = TxRequest::SCHEDULE;
+      fleet[slot].tx_due = fleet[slot].next_tx;
+
+      // Keep the schedule unless the transmission is late by more than one interval
+      uint32_t interval_ms = tx_interval * 1000UL;
+      uint32_t lag = now - fleet[slot].next_tx;
+      fleet[slot].next_tx = ((lag < interval_ms) ? fleet[slot].next_tx : now) + fleet[slot].traffic.next(interval_ms);
+    }
+    TASK_END();
+  }
+};
+
+//
+// Encoder - encodes the frame of the sensor which is due first as soon as
+// the frame buffer is free, i.e. while the previous frame is on air
+//
+class EncodeTask : public Task {
+public:
+  void run(uint32_t now) override
+  {
+    TASK_BEGIN();
+    for (;;)
+    {
+      TASK_WAIT_UNTIL(!tx_frame.ready && (_slot = nextTxRequest()) != UINT8_MAX);
+      if (fleet[_slot].tx_request == TxRequest::SCHEDULE)
+      {
+        tx_stats.lag_ms.add(now - fleet[_slot].tx_due);
+      }
+      fleet[_slot].tx_request = TxRequest::NONE;
+      encodeFrame(_slot);
+    }
+    TASK_END();
+  }
+
+private:
+  uint8_t _slot;
+};
+
+//
+// Radio driver - starts the transmission of the encoded frame and waits for
+// the packet sent interrupt (or timeout) without blocking the other tasks
+//
+class RadioTask : public Task {
+public:
+  RadioTask() : _busy(false)
+  {
+  }
+
+  bool busy(void) const
+  {
+    return _busy;
+  }
+
+  void run(uint32_t now) override
+  {
+    TASK_BEGIN();
+    for (;;)
+    {
+      TASK_WAIT_UNTIL(tx_frame.ready);
+      {
+        PROBE_BEGIN(LOG);
+        log_i("%s Transmitting packet (%d bytes)... ", TRANSCEIVER_CHIP, (int)tx_frame.size);
+        PROBE_END(LOG);
+      }
+      _enc = tx_frame.enc;
+      _size = tx_frame.size;
+      _timeout_us = 5 * airtimeUs(RADIO_OVERHEAD_BYTES + _size, TX_BITRATE);
+      _busy = true;
+      tx_done.take();
+      _t_start = micros();
+      {
+        PROBE_BEGIN(TRANSMIT);
+        _state = radio.startTransmit(tx_frame.data, _size);
+        PROBE_END(TRANSMIT);
+      }
+
+      // The frame has been written to the transceiver - the buffer is free for the next one
+      tx_frame.ready = false;
+      if (_state == RADIOLIB_ERR_NONE)
+      {
+        TASK_WAIT_UNTIL(tx_done.isSet() || micros() - _t_start > _timeout_us);
+        _state = tx_done.take() ? RADIOLIB_ERR_NONE : RADIOLIB_ERR_TX_TIMEOUT;
+        radio.finishTransmit();
+      }
+      _busy = false;
+      txResult(_enc, _size, _state, micros() - _t_start);
+    }
+    TASK_END();
+  }
+
+private:
+  uint32_t _t_start;    // start of transmission in us
+  uint32_t _timeout_us; // max. duration of transmission
+  int16_t _state;       // RadioLib status code
+  uint8_t _size;        // frame size in bytes
+  Encoders _enc;        // encoder (statistics)
+  bool _busy;           // transmission in progress
+};
+
+static InputTask input_task;
+static SensorTask sensor_task[MAX_FLEET_SIZE];
+static EncodeTask encode_task;
+static RadioTask radio_task;
+static Scheduler<MAX_FLEET_SIZE + 3> scheduler;
+
+//
+// No transmission requested or in progress
+//
+bool txIdle(void)
+{
+  return nextTxRequest() == UINT8_MAX && !tx_frame.ready && !radio_task.busy();
+}
+
+//
+// Add tasks to scheduler - the order of execution within one pass of loop()
+//
+void tasksBegin(void)
+{
+  scheduler.add(&input_task);
+  for (uint8_t i = 0; i < MAX_FLEET_SIZE; i++)
+  {
+    sensor_task[i].slot = i;
+    scheduler.add(&sensor_task[i]);
+  }
+  scheduler.add(&encode_task);
+  scheduler.add(&radio_task);
+}
+
+void loop()
+{
+  scheduler.run(millis());
+
+  // Print requested statistics after transmission to avoid delaying it
+  printStatsRequest();
 }
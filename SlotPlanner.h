@@ -0,0 +1,331 @@
+///////////////////////////////////////////////////////////////////////////////
+// SlotPlanner.h
+//
+// Transmit phase planner for a fleet of periodic emulated sensors
+//
+// All sensors share one radio and transmit with the same period. The planner
+// assigns each sensor a phase offset within the period such that the frames
+// (of known airtime) do not overlap and do not queue behind each other.
+//
+// Sensors are added incrementally: a new sensor is placed in the middle of
+// the largest gap between the existing phases, so the phases of the other
+// sensors are not changed. Removing a sensor just leaves a gap which is
+// filled by the next sensor added. The smallest gap is always >= period / (2 * n).
+// If this is less than the airtime although the frames would fit with
+// equidistant phases, the complete plan is re-computed.
+//
+// Limitation: the plan is only valid for a single common period. Sensors
+// with different transmit intervals (e.g. 5-in-1 and lightning sensors in
+// one fleet) would have to be planned over the least common multiple of
+// their intervals; this is not supported. SensorTransmitter uses one
+// interval (tx_interval) for all emulated sensors.
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Documented single period limitation
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef SLOT_PLANNER_H
+#define SLOT_PLANNER_H
+
+#include <Arduino.h>
+
+/*!
+ * \brief Transmit phase planner
+ *
+ * Times are given in microseconds, i.e. the period must be less than
+ * 2^32 us (~71 minutes). All sensors transmit with the same period.
+ *
+ * \tparam N max. number of sensors
+ */
+template <uint16_t N>
+class SlotPlanner {
+public:
+    static const uint32_t SATURATED = UINT32_MAX; //!< lag if the frames do not fit into the period
+
+    SlotPlanner() : _period(1), _airtime(0), _count(0), _replanned(false)
+    {
+    }
+
+    /*!
+     * \brief Remove all sensors and set period and airtime
+     *
+     * \param period_us     transmit period
+     * \param airtime_us    frame airtime
+     */
+    void begin(uint32_t period_us, uint32_t airtime_us)
+    {
+        _period = period_us ? period_us : 1;
+        _airtime = airtime_us;
+        _count = 0;
+    }
+
+    /*!
+     * \brief Set frame airtime (e.g. after change of encoder)
+     *
+     * The phases are kept; re-plan if the frames do not fit anymore.
+     *
+     * \returns true if the phases have been re-computed
+     */
+    bool setAirtime(uint32_t airtime_us)
+    {
+        _airtime = airtime_us;
+        _replanned = false;
+        if (needsReplan())
+        {
+            replan();
+        }
+        return _replanned;
+    }
+
+    /*!
+     * \brief Change number of sensors
+     *
+     * Sensors are added or removed at the end; the phases of the remaining
+     * sensors are kept if possible.
+     *
+     * \param n number of sensors (limited to N)
+     *
+     * \returns true if the phases of the remaining sensors have been re-computed
+     */
+    bool resize(uint16_t n)
+    {
+        if (n > N)
+        {
+            n = N;
+        }
+        _replanned = false;
+        while (_count > n)
+        {
+            remove(_count - 1);
+        }
+        while (_count < n)
+        {
+            add();
+        }
+        return _replanned;
+    }
+
+    /*!
+     * \brief Add sensor
+     *
+     * \returns index of new sensor or -1 if full
+     */
+    int add(void)
+    {
+        if (_count >= N)
+        {
+            return -1;
+        }
+
+        uint32_t phase = 0;
+        uint16_t pos = 0;
+        if (_count > 0)
+        {
+            // Find largest gap between consecutive phases (cyclic)
+            uint32_t max_gap = 0;
+            for (uint16_t k = 0; k < _count; k++)
+            {
+                uint32_t gap = distance(k);
+                if (gap > max_gap)
+                {
+                    max_gap = gap;
+                    pos = k;
+                }
+            }
+            phase = _phase[_order[pos]] + max_gap / 2;
+            if (phase >= _period)
+            {
+                phase -= _period;
+            }
+            pos++;
+            if (phase < _phase[_order[0]])
+            {
+                // Wrapped around - insert at start of order
+                pos = 0;
+            }
+        }
+
+        uint16_t id = _count++;
+        _phase[id] = phase;
+        memmove(&_order[pos + 1], &_order[pos], (_count - 1 - pos) * sizeof(_order[0]));
+        _order[pos] = id;
+
+        if (needsReplan())
+        {
+            replan();
+        }
+        return id;
+    }
+
+    /*!
+     * \brief Remove sensor
+     *
+     * The indices of the following sensors are decremented.
+     *
+     * \param id sensor index
+     */
+    void remove(uint16_t id)
+    {
+        if (id >= _count)
+        {
+            return;
+        }
+        uint16_t k = 0;
+        for (uint16_t i = 0; i < _count; i++)
+        {
+            if (_order[i] == id)
+            {
+                continue;
+            }
+            _order[k++] = (_order[i] > id) ? _order[i] - 1 : _order[i];
+        }
+        memmove(&_phase[id], &_phase[id + 1], (_count - 1 - id) * sizeof(_phase[0]));
+        _count--;
+    }
+
+    /*!
+     * \brief Assign equidistant phases to all sensors
+     */
+    void replan(void)
+    {
+        for (uint16_t i = 0; i < _count; i++)
+        {
+            _phase[i] = (uint64_t)_period * i / _count;
+            _order[i] = i;
+        }
+        _replanned = true;
+    }
+
+    //! Phase offset of sensor in microseconds
+    inline uint32_t phase(uint16_t id) const
+    {
+        return _phase[id];
+    }
+
+    //! Number of sensors
+    inline uint16_t size(void) const
+    {
+        return _count;
+    }
+
+    //! Frame airtime in microseconds
+    inline uint32_t airtime(void) const
+    {
+        return _airtime;
+    }
+
+    //! Smallest distance between the phases of two sensors in microseconds
+    uint32_t minGap(void) const
+    {
+        uint32_t min_gap = _period;
+        for (uint16_t k = 0; k < _count; k++)
+        {
+            uint32_t gap = distance(k);
+            if (gap < min_gap)
+            {
+                min_gap = gap;
+            }
+        }
+        return min_gap;
+    }
+
+    /*!
+     * \brief Worst-case transmit start lag
+     *
+     * A frame can only start after the previous frame has ended. The radio
+     * is evaluated over two periods to include frames queued across the
+     * end of the period.
+     *
+     * \returns max. delay between scheduled and actual start of transmission
+     *          in microseconds or SATURATED
+     */
+    uint32_t worstLag(void) const
+    {
+        if (_count == 0)
+        {
+            return 0;
+        }
+        if ((uint64_t)_count * _airtime > _period)
+        {
+            return SATURATED;
+        }
+
+        uint32_t max_lag = 0;
+        uint64_t end = 0;
+        for (uint8_t round = 0; round < 2; round++)
+        {
+            for (uint16_t k = 0; k < _count; k++)
+            {
+                uint64_t scheduled = (uint64_t)round * _period + _phase[_order[k]];
+                uint64_t start = (end > scheduled) ? end : scheduled;
+                if (start - scheduled > max_lag)
+                {
+                    max_lag = start - scheduled;
+                }
+                end = start + _airtime;
+            }
+        }
+        return max_lag;
+    }
+
+private:
+    uint32_t _period;           //!< transmit period in us
+    uint32_t _airtime;          //!< frame airtime in us
+    uint16_t _count;            //!< number of sensors
+    uint32_t _phase[N];         //!< phase offset per sensor in us
+    uint16_t _order[N];         //!< sensor indices sorted by phase
+    bool _replanned;            //!< replan() called since last resize()/setAirtime()
+
+    //! Distance from k-th to next phase in order (cyclic)
+    inline uint32_t distance(uint16_t k) const
+    {
+        uint32_t cur = _phase[_order[k]];
+        if (k + 1 < _count)
+        {
+            return _phase[_order[k + 1]] - cur;
+        }
+        return _period - cur + _phase[_order[0]];
+    }
+
+    //! Incremental plan has overlapping frames, but equidistant phases would not
+    inline bool needsReplan(void) const
+    {
+        return (_count > 1) && (minGap() < _airtime) && ((uint64_t)_count * _airtime <= _period);
+    }
+};
+
+#endif // SLOT_PLANNER_H
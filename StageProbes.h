@@ -0,0 +1,254 @@
+///////////////////////////////////////////////////////////////////////////////
+// StageProbes.h
+//
+// Cycle counter based run time probes for the stages of the transmit path
+// (input parsing, JSON deserialization, encoding, transmission and logging)
+//
+// The probes are only compiled if STAGE_PROBES is defined (see
+// SensorTransmitter.h), otherwise PROBE_BEGIN()/PROBE_END() expand to nothing.
+//
+// Cycle counter:
+// - Xtensa (ESP32, ESP32-S2/S3, ESP8266): CCOUNT register
+// - ESP32 (RISC-V):                       ESP.getCycleCount()
+// - RP2040:                               rp2040.getCycleCount() (SysTick based)
+// - x86 (host):                           time stamp counter (rdtsc)
+// - other hosts:                          clock_gettime() in us
+// - others:                               micros()
+//
+// Does not depend on the Arduino core on the host. The breakdown is printed
+// with integer arithmetic only (no floating point formatting on AVR).
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Removed stage DATARATE (radio.getDataRate() is not used anymore);
+//          TRANSMIT: radio.startTransmit()
+//          Host build without Arduino core; print() to any output with
+//          print(const char *), integer formatting
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef STAGE_PROBES_H
+#define STAGE_PROBES_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(ARDUINO)
+#include <Arduino.h>
+#endif
+
+#if defined(STAGE_PROBES)
+
+#if !defined(__XTENSA__) && !defined(ESP32) && !defined(ARDUINO_ARCH_RP2040) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#elif !defined(ARDUINO)
+#include <time.h>
+#endif
+
+/*!
+ * \brief Read cycle counter
+ *
+ * \returns cycle count (wraps around)
+ */
+static inline uint32_t cycleCount(void)
+{
+#if defined(__XTENSA__)
+    uint32_t ccount;
+    __asm__ __volatile__("rsr %0, ccount" : "=a"(ccount));
+    return ccount;
+#elif defined(ESP32)
+    return ESP.getCycleCount();
+#elif defined(ARDUINO_ARCH_RP2040)
+    return rp2040.getCycleCount();
+#elif defined(__x86_64__) || defined(__i386__)
+    return static_cast<uint32_t>(__rdtsc());
+#elif !defined(ARDUINO)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint32_t>(ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000);
+#else
+    return micros();
+#endif
+}
+
+/*!
+ * \brief Cycle counter frequency
+ *
+ * \returns cycles per microsecond (0 if not known)
+ */
+static inline uint32_t cyclesPerUs(void)
+{
+#if defined(ESP32)
+    return getCpuFrequencyMhz();
+#elif defined(ESP8266) && defined(__XTENSA__)
+    return ESP.getCpuFreqMHz();
+#elif defined(ARDUINO_ARCH_RP2040)
+    return rp2040.f_cpu() / 1000000;
+#elif defined(__x86_64__) || defined(__i386__)
+    return 0;
+#else
+    return 1;
+#endif
+}
+
+/*!
+ * \brief Run time per transmit path stage in cycles
+ *
+ * Each PROBE_BEGIN()/PROBE_END() pair adds one sample to its stage.
+ */
+class StageProbes {
+public:
+    //! Stages
+    enum Stage : uint8_t {
+        PARSE,          //!< input line parsing (handleCommand())
+        DESERIALIZE,    //!< JSON deserialization (deSerialize())
+        ENCODE,         //!< payload encoding and whitening
+        TRANSMIT,       //!< radio.startTransmit()
+        LOG,            //!< logging
+        NUM_STAGES
+    };
+
+    StageProbes()
+    {
+        reset();
+    }
+
+    void reset(void)
+    {
+        memset(_table, 0, sizeof(_table));
+        for (Entry &e : _table)
+        {
+            e.min = UINT32_MAX;
+        }
+    }
+
+    inline void add(Stage stage, uint32_t cycles)
+    {
+        Entry &e = _table[stage];
+        e.count++;
+        e.sum += cycles;
+        if (cycles < e.min)
+        {
+            e.min = cycles;
+        }
+        if (cycles > e.max)
+        {
+            e.max = cycles;
+        }
+    }
+
+    /*!
+     * \brief Print per-stage breakdown
+     *
+     * \param out   output (e.g. Serial) - print(const char *) is used
+     */
+    template <typename Out>
+    void print(Out &out) const
+    {
+        static const char *const names[NUM_STAGES] = {
+            "parse", "deserialize", "encode", "transmit", "log"
+        };
+        uint64_t total = 0;
+        for (const Entry &e : _table)
+        {
+            total += e.sum;
+        }
+        uint32_t mhz = cyclesPerUs();
+        char buf[96];
+
+        snprintf(buf, sizeof(buf), "%-12s %8s %10s %10s %10s %10s %6s\n", "Stage", "Count", "Min", "Avg", "Max", "Avg [us]", "Share");
+        out.print(buf);
+        for (uint8_t i = 0; i < NUM_STAGES; i++)
+        {
+            const Entry &e = _table[i];
+            if (e.count == 0)
+            {
+                snprintf(buf, sizeof(buf), "%-12s %8d\n", names[i], 0);
+                out.print(buf);
+                continue;
+            }
+            uint32_t avg = e.sum / e.count;
+            int n = snprintf(buf, sizeof(buf), "%-12s %8lu %10lu %10lu %10lu ", names[i], (unsigned long)e.count,
+                             (unsigned long)e.min, (unsigned long)avg, (unsigned long)e.max);
+            if (mhz)
+            {
+                // Average in 0.01 us
+                unsigned long avg_us100 = ((uint64_t)avg * 100 + mhz / 2) / mhz;
+                n += snprintf(&buf[n], sizeof(buf) - n, "%7lu.%02lu ", avg_us100 / 100, avg_us100 % 100);
+            }
+            else
+            {
+                n += snprintf(&buf[n], sizeof(buf) - n, "%10s ", "-");
+            }
+            // Share in 0.1 %
+            unsigned share = total ? (e.sum * 1000 + total / 2) / total : 0;
+            snprintf(&buf[n], sizeof(buf) - n, "%3u.%u%%\n", share / 10, share % 10);
+            out.print(buf);
+        }
+        if (mhz)
+        {
+            snprintf(buf, sizeof(buf), "Cycle counter: %lu MHz\n", (unsigned long)mhz);
+            out.print(buf);
+        }
+    }
+
+private:
+    struct Entry {
+        uint32_t count;     //!< number of samples
+        uint32_t min;       //!< min. cycles
+        uint32_t max;       //!< max. cycles
+        uint64_t sum;       //!< total cycles
+    };
+
+    Entry _table[NUM_STAGES];
+};
+
+extern StageProbes stage_probes;
+
+//! Start probe of stage (in the current scope)
+#define PROBE_BEGIN(stage) uint32_t probe_##stage = cycleCount()
+
+//! Stop probe of stage and add sample
+#define PROBE_END(stage) stage_probes.add(StageProbes::stage, cycleCount() - probe_##stage)
+
+#else
+
+#define PROBE_BEGIN(stage)
+#define PROBE_END(stage)
+
+#endif // STAGE_PROBES
+
+#endif // STAGE_PROBES_H
@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////////
+// Tasks.h
+//
+// Cooperative stackless tasks (protothreads)
+//
+// A task is an object with a run() method which is called by the scheduler
+// on each pass of loop(). The body is enclosed in TASK_BEGIN()/TASK_END();
+// TASK_WAIT_UNTIL(<condition>) returns from run() and resumes at the same
+// point on the next call once the condition is met. The resume point is a
+// source line number, i.e. a task needs 2 bytes of state plus the vtable
+// pointer - there is no stack per task. Consequently, local variables are
+// not kept across waits (use members instead), and waits must not be used
+// inside a switch statement of the task body.
+//
+// Events are flags which can be set from interrupts; timers are waits on
+// the time passed to run().
+//
+// C++20 coroutines would allow locals across suspension points, but the
+// ESP8266 and RP2040 cores compile with C++17 and coroutine frames are
+// allocated from the heap (see extras/task_bench for a comparison).
+//
+// Does not depend on the Arduino core (usable on the host).
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TASKS_H
+#define TASKS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) && (__GNUC__ >= 7)
+    #define TASK_FALLTHROUGH __attribute__((fallthrough))
+#else
+    #define TASK_FALLTHROUGH
+#endif
+
+//! Start of task body
+#define TASK_BEGIN() \
+    switch (_pt)     \
+    {                \
+    case 0:
+
+//! Wait until condition is met (evaluated on each call of run())
+#define TASK_WAIT_UNTIL(cond) \
+    do                        \
+    {                         \
+        _pt = __LINE__;       \
+        TASK_FALLTHROUGH;     \
+    case __LINE__:            \
+        if (!(cond))          \
+        {                     \
+            return;           \
+        }                     \
+    } while (0)
+
+//! Return to the scheduler and resume on the next call
+#define TASK_YIELD()    \
+    do                  \
+    {                   \
+        _pt = __LINE__; \
+        return;         \
+    case __LINE__:;     \
+    } while (0)
+
+//! End of task body - the task is started again on the next call
+#define TASK_END() \
+    }              \
+    _pt = 0
+
+/*!
+ * \brief Stackless task
+ */
+class Task {
+public:
+    Task() : _pt(0)
+    {
+    }
+
+    /*!
+     * \brief Run task until it waits
+     *
+     * \param now   time in ms (millis())
+     */
+    virtual void run(uint32_t now) = 0;
+
+    //! Start task body from the beginning on the next call
+    void restart(void)
+    {
+        _pt = 0;
+    }
+
+protected:
+    uint16_t _pt; //!< resume point (source line), 0: start
+};
+
+/*!
+ * \brief Event flag - can be set from interrupts
+ */
+class Event {
+public:
+    Event() : _set(false)
+    {
+    }
+
+    void set(void)
+    {
+        _set = true;
+    }
+
+    bool isSet(void) const
+    {
+        return _set;
+    }
+
+    //! Clear event, returns true if it was set
+    bool take(void)
+    {
+        if (!_set)
+        {
+            return false;
+        }
+        _set = false;
+        return true;
+    }
+
+private:
+    volatile bool _set;
+};
+
+/*!
+ * \brief Round-robin scheduler
+ *
+ * \tparam N max. number of tasks
+ */
+template <size_t N>
+class Scheduler {
+public:
+    Scheduler() : _count(0)
+    {
+    }
+
+    //! Add task - returns false if the task table is full
+    bool add(Task *task)
+    {
+        if (_count == N)
+        {
+            return false;
+        }
+        _task[_count++] = task;
+        return true;
+    }
+
+    /*!
+     * \brief Run each task once (in the order added)
+     *
+     * \param now   time in ms (millis())
+     */
+    void run(uint32_t now)
+    {
+        for (size_t i = 0; i < _count; i++)
+        {
+            _task[i]->run(now);
+        }
+    }
+
+private:
+    Task *_task[N];
+    size_t _count;
+};
+
+#endif // TASKS_H
@@ -0,0 +1,205 @@
+///////////////////////////////////////////////////////////////////////////////
+// TrafficModel.h
+//
+// Arrival processes for emulated sensor transmissions
+//
+// - PERIODIC: fixed interval
+// - JITTER:   interval +/- uniformly distributed deviation
+// - POISSON:  exponentially distributed inter-arrival times
+// - BURST:    bursts of frames, bursts arriving as Poisson process
+//
+// The mean transmission rate of each sensor is 1/interval for all models,
+// i.e. the offered load only depends on the number of sensors, the interval
+// and the frame airtime. All random numbers are taken from a per-sensor
+// xorshift32 PRNG, so a traffic pattern is reproducible from its seed.
+//
+// Does not depend on the Arduino core (usable on the host).
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          first(): Added planned phase
+//          Usable on the host (extras/farm_sim)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TRAFFIC_MODEL_H
+#define TRAFFIC_MODEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <math.h>
+
+#if defined(ARDUINO)
+    #include <Arduino.h>
+#endif
+
+#define TRAFFIC_BURST_GAP_MS 100    //!< gap between frames of a burst in ms
+
+//! Arrival process
+enum struct Traffic : uint8_t {
+    PERIODIC,
+    JITTER,
+    POISSON,
+    BURST
+};
+
+/*!
+ * \brief Frame airtime
+ *
+ * \param bytes     frame size in bytes (incl. preamble and sync word)
+ * \param kbps      bit rate in kbps
+ *
+ * \returns airtime in microseconds
+ */
+inline uint32_t airtimeUs(size_t bytes, float kbps)
+{
+    return (uint32_t)(bytes * 8 * 1000 / kbps);
+}
+
+/*!
+ * \brief Pure ALOHA collision probability
+ *
+ * \param load  offered load in Erlang
+ *
+ * \returns probability that a frame overlaps with any other frame
+ */
+inline float collisionProbability(float load)
+{
+    return 1.0f - expf(-2.0f * load);
+}
+
+/*!
+ * \brief Arrival process state of one emulated sensor
+ */
+struct TrafficModel {
+    Traffic type;           //!< arrival process
+    uint16_t param;         //!< JITTER: max. deviation in ms, BURST: frames per burst
+    uint32_t rng;           //!< xorshift32 PRNG state
+    uint16_t burst_left;    //!< remaining frames of current burst
+
+    /*!
+     * \brief Seed PRNG
+     *
+     * \param seed  common seed
+     * \param index sensor index
+     */
+    void seed(uint32_t seed, uint16_t index)
+    {
+        // splitmix32 finalizer - decorrelates the per-sensor streams
+        uint32_t z = seed + 0x9E3779B9UL * (index + 1);
+        z = (z ^ (z >> 16)) * 0x85EBCA6BUL;
+        z = (z ^ (z >> 13)) * 0xC2B2AE35UL;
+        z ^= z >> 16;
+        rng = z ? z : 1;
+        burst_left = 0;
+    }
+
+    //! Next pseudo random number
+    inline uint32_t rand32(void)
+    {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+
+    //! Uniformly distributed random number in (0, 1]
+    inline float uniform(void)
+    {
+        return ((rand32() >> 8) + 1) * (1.0f / 16777216.0f);
+    }
+
+    //! Exponentially distributed random number with given mean
+    inline uint32_t exponential(uint32_t mean)
+    {
+        return (uint32_t)(-logf(uniform()) * mean);
+    }
+
+    /*!
+     * \brief Time until first transmission after (re-)start
+     *
+     * PERIODIC and JITTER use the planned phase, all other models
+     * a random phase.
+     *
+     * \param interval_ms   mean transmit interval in ms
+     * \param phase_ms      planned phase in ms
+     *
+     * \returns delay in ms
+     */
+    uint32_t first(uint32_t interval_ms, uint32_t phase_ms)
+    {
+        if (type == Traffic::PERIODIC || type == Traffic::JITTER)
+        {
+            return phase_ms;
+        }
+        return rand32() % interval_ms;
+    }
+
+    /*!
+     * \brief Time until next transmission
+     *
+     * \param interval_ms   mean transmit interval in ms
+     *
+     * \returns delay in ms
+     */
+    uint32_t next(uint32_t interval_ms)
+    {
+        switch (type)
+        {
+        case Traffic::JITTER:
+        {
+            uint32_t jitter = (param < interval_ms) ? param : interval_ms - 1;
+            return interval_ms - jitter + rand32() % (2 * jitter + 1);
+        }
+
+        case Traffic::POISSON:
+            return exponential(interval_ms);
+
+        case Traffic::BURST:
+            if (burst_left > 1)
+            {
+                burst_left--;
+                return TRAFFIC_BURST_GAP_MS;
+            }
+            burst_left = param ? param : 1;
+            return exponential(interval_ms * burst_left);
+
+        default:
+            return interval_ms;
+        }
+    }
+};
+
+#endif // TRAFFIC_MODEL_H
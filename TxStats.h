@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////
+// TxStats.h
+//
+// Runtime statistics - transmitted frames, transmit errors,
+// data generation/encoding/transmit time and scheduling lag histograms,
+// heap usage
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Added gen_us
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TX_STATS_H
+#define TX_STATS_H
+
+#include <Arduino.h>
+#include <RadioLib.h>
+
+//! Statistics output format
+enum struct StatsFormat {
+    NONE,
+    TEXT,
+    JSON
+};
+
+/*!
+ * \brief Histogram with fixed log2 buckets
+ *
+ * Bucket 0 counts the value 0, bucket i (i > 0) counts values in the
+ * range [2^(i-1), 2^i). The last bucket also counts all larger values.
+ */
+class Log2Histogram {
+public:
+    static const uint8_t NUM_BUCKETS = 20;
+
+    Log2Histogram()
+    {
+        reset();
+    }
+
+    inline void reset(void)
+    {
+        memset(_count, 0, sizeof(_count));
+        _max = 0;
+    }
+
+    inline void add(uint32_t val)
+    {
+        uint8_t i = (val == 0) ? 0 : 32 - __builtin_clz(val);
+        if (i >= NUM_BUCKETS)
+        {
+            i = NUM_BUCKETS - 1;
+        }
+        _count[i]++;
+        if (val > _max)
+        {
+            _max = val;
+        }
+    }
+
+    inline uint32_t count(uint8_t i) const
+    {
+        return _count[i];
+    }
+
+    inline uint32_t max(void) const
+    {
+        return _max;
+    }
+
+    //! Lower bound of bucket i
+    static inline uint32_t lowerBound(uint8_t i)
+    {
+        return (i == 0) ? 0 : 1UL << (i - 1);
+    }
+
+private:
+    uint32_t _count[NUM_BUCKETS];
+    uint32_t _max;
+};
+
+/*!
+ * \brief Transmitter statistics
+ */
+struct TxStats {
+    static const uint8_t MAX_ENCODERS = 8;   //!< max. number of encoders
+    static const uint8_t MAX_ERR_CODES = 4;  //!< max. number of distinct 'other' error codes
+
+    uint32_t frames[MAX_ENCODERS];           //!< frames sent per encoder (index: Encoders)
+    uint32_t err_too_long;                   //!< RADIOLIB_ERR_PACKET_TOO_LONG
+    uint32_t err_timeout;                    //!< RADIOLIB_ERR_TX_TIMEOUT
+    uint32_t err_other;                      //!< all other error codes
+    struct {
+        int16_t code;
+        uint32_t count;
+    } err_codes[MAX_ERR_CODES];              //!< first distinct 'other' error codes
+    Log2Histogram gen_us;                    //!< data generation time in microseconds (DATA_GEN)
+    Log2Histogram encode_us;                 //!< encoding time in microseconds
+    Log2Histogram tx_us;                     //!< transmit time in microseconds
+    Log2Histogram lag_ms;                    //!< scheduling lag in milliseconds
+    uint32_t heap_min;                       //!< minimum free heap observed
+
+    TxStats()
+    {
+        reset();
+    }
+
+    void reset(void)
+    {
+        memset(frames, 0, sizeof(frames));
+        err_too_long = 0;
+        err_timeout = 0;
+        err_other = 0;
+        memset(err_codes, 0, sizeof(err_codes));
+        gen_us.reset();
+        encode_us.reset();
+        tx_us.reset();
+        lag_ms.reset();
+        heap_min = UINT32_MAX;
+    }
+
+    /*!
+     * \brief Count transmit result
+     *
+     * \param encoder   encoder index
+     * \param state     RadioLib status code
+     */
+    void txResult(uint8_t encoder, int state)
+    {
+        if (state == RADIOLIB_ERR_NONE)
+        {
+            if (encoder < MAX_ENCODERS)
+            {
+                frames[encoder]++;
+            }
+        }
+        else if (state == RADIOLIB_ERR_PACKET_TOO_LONG)
+        {
+            err_too_long++;
+        }
+        else if (state == RADIOLIB_ERR_TX_TIMEOUT)
+        {
+            err_timeout++;
+        }
+        else
+        {
+            err_other++;
+            for (uint8_t i = 0; i < MAX_ERR_CODES; i++)
+            {
+                if (err_codes[i].count == 0 || err_codes[i].code == state)
+                {
+                    err_codes[i].code = state;
+                    err_codes[i].count++;
+                    break;
+                }
+            }
+        }
+    }
+
+    /*!
+     * \brief Sample free heap and update minimum
+     *
+     * \returns free heap in bytes (0 if not available)
+     */
+    uint32_t heapFree(void)
+    {
+        uint32_t free_heap;
+#if defined(ESP32)
+        free_heap = ESP.getFreeHeap();
+        heap_min = ESP.getMinFreeHeap();
+#else
+    #if defined(ESP8266)
+        free_heap = ESP.getFreeHeap();
+    #elif defined(ARDUINO_ARCH_RP2040)
+        free_heap = rp2040.getFreeHeap();
+    #else
+        free_heap = 0;
+    #endif
+        if (free_heap < heap_min)
+        {
+            heap_min = free_heap;
+        }
+#endif
+        return free_heap;
+    }
+};
+
+#endif // TX_STATS_H
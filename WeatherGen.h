@@ -0,0 +1,435 @@
+///////////////////////////////////////////////////////////////////////////////
+// WeatherGen.h
+//
+// Synthetic weather time series for emulated sensors (DATA_GEN)
+//
+// Each sensor has its own state and pseudo random number generator; the
+// trajectories are reproducible from the seed and the sensor index.
+//
+// - Temperature:   diurnal cycle (min. at 03:00, max. at 15:00), damped by
+//                  clouds, colder when raining, plus slow random deviation
+// - Humidity:      anti-correlated with temperature, higher when raining
+// - Wind:          slowly changing mean speed with turbulence and gusts,
+//                  direction drifting as random walk
+// - Rain:          rain events as random process, the rain gauge value
+//                  increases monotonically
+// - Light/UV:      sun elevation (06:00...18:00), attenuated by clouds
+// - Soil:          temperature follows air temperature with lag, moisture
+//                  increases with rain and dries out slowly
+// - Air quality:   PM (washed out by rain), CO2 (indoor occupancy), HCHO/VOC
+// - Lightning:     strikes during thunderstorms, distance as random walk
+// - Leakage:       rare alarms of 10 minutes
+//
+// All calculations use integer/fixed-point arithmetic; floating point
+// values are only produced when writing the sensor data.
+//
+// Does not depend on the Arduino core (usable on the host, see
+// extras/weather_bench).
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          update(): Sensor data as scaled integers (SensorRecord) - no floating
+//          point conversion
+//          Host build: no Arduino core, sensor types from PayloadEncoders.h
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef WEATHER_GEN_H
+#define WEATHER_GEN_H
+
+#include <stdint.h>
+
+#include "PayloadEncoders.h"
+
+/*!
+ * \brief Weather time series generator for one sensor
+ *
+ * Units of the internal state: temperature in 0.01 degC, humidity and
+ * soil moisture in 0.01 %, wind speed in cm/s, wind direction in 0.1 deg,
+ * rain in um, cloud cover in Q15 (0...32767), PM in 0.1 ug/m3.
+ */
+class WeatherGen {
+public:
+    /*!
+     * \brief Initialize state
+     *
+     * \param seed          common seed
+     * \param index         sensor index
+     * \param start_s       simulated time of day at start in seconds
+     * \param time_scale    simulated seconds per real second
+     */
+    void begin(uint32_t seed, uint16_t index, uint32_t start_s, uint16_t time_scale)
+    {
+        // splitmix32 finalizer - decorrelates the per-sensor streams
+        uint32_t z = seed + 0x9E3779B9UL * (index + 1);
+        z = (z ^ (z >> 16)) * 0x85EBCA6BUL;
+        z = (z ^ (z >> 13)) * 0xC2B2AE35UL;
+        z ^= z >> 16;
+        _rng = z ? z : 1;
+
+        _t_s = start_s;
+        _scale = time_scale ? time_scale : 1;
+        _ms_acc = 0;
+        _started = false;
+
+        _temp_mean = 1000 + noise(600);
+        _temp_amp = 600 + noise(200);
+        _temp_dev = 0;
+        _hum_dev = 0;
+        _cloud = _cloud_target = rand32() & 0x7FFF;
+        _raining = false;
+        _storm = false;
+        _rain_rate = 0;
+        _rain_um = 0;
+        _rain_acc = 0;
+        _wind_avg = _wind_target = 150 + rand32() % 300;
+        _wind_dir = rand32() % 3600;
+        _dir_drift = 0;
+        _soil_moist = 3000 + noise(1000);
+        _pm = 120;
+        _co2 = 500;
+        _hcho = 20;
+        _strikes = 0;
+        _distance = 20;
+        _leak_s = 0;
+    }
+
+    /*!
+     * \brief Advance time series to current time and write sensor data
+     *
+     * The fields written depend on the sensor type (s.s_type).
+     *
+     * \param s         sensor data (SensorRecord)
+     * \param now_ms    current time in milliseconds
+     */
+    template <typename T>
+    void update(T &s, uint32_t now_ms)
+    {
+        uint32_t dt = 0;
+        if (_started)
+        {
+            _ms_acc += (uint64_t)(now_ms - _last_ms) * _scale;
+            dt = _ms_acc / 1000;
+            _ms_acc %= 1000;
+        }
+        _last_ms = now_ms;
+        _t_s += dt;
+        step(dt);
+        _started = true;
+
+        switch (s.s_type)
+        {
+        case SENSOR_TYPE_SOIL:
+            s.soil.temp_c10 = divRound(_soil_temp, 10);
+            s.soil.moisture = _soil_moist / 100;
+            break;
+
+        case SENSOR_TYPE_AIR_PM:
+            s.pm.pm_2_5 = _pm / 10;
+            s.pm.pm_10 = _pm * 16 / 100;
+            break;
+
+        case SENSOR_TYPE_CO2:
+            s.co2.co2_ppm = _co2;
+            break;
+
+        case SENSOR_TYPE_HCHO_VOC:
+            s.voc.hcho_ppb = _hcho;
+            s.voc.voc_level = clamp(1 + (_co2 - 400) / 300, 1, 5);
+            break;
+
+        case SENSOR_TYPE_LIGHTNING:
+            s.lgt.strike_count = _strikes;
+            s.lgt.distance_km = _distance;
+            break;
+
+        case SENSOR_TYPE_LEAKAGE:
+            s.leak.alarm = (_leak_s > 0);
+            break;
+
+        default:
+            s.w.temp_c10 = divRound(_temp, 10);
+            s.w.humidity = _humidity / 100;
+            s.w.wind_avg_ms10 = divRound(_wind_out, 10);
+            s.w.wind_gust_ms10 = divRound(_gust, 10);
+            s.w.wind_dir_deg10 = _wind_dir;
+            s.w.rain_mm10 = (_rain_um + 50) / 100;
+            s.w.uv10 = _uv;
+            s.w.light_lux = _lux;
+            break;
+        }
+    }
+
+private:
+    uint32_t _rng;          //!< xorshift32 PRNG state
+    uint32_t _t_s;          //!< simulated time in s
+    uint32_t _last_ms;      //!< time of last update in ms
+    uint32_t _ms_acc;       //!< simulated time not yet accounted for in ms
+    uint16_t _scale;        //!< time scale
+    bool _started;          //!< first update done
+    bool _raining;          //!< rain event in progress
+    bool _storm;            //!< rain event is a thunderstorm
+    int32_t _temp_mean;     //!< daily mean temperature
+    int32_t _temp_amp;      //!< diurnal temperature amplitude
+    int32_t _temp_dev;      //!< slow random temperature deviation
+    int32_t _temp;          //!< temperature
+    int32_t _hum_dev;       //!< slow random humidity deviation
+    int32_t _humidity;      //!< humidity
+    int32_t _cloud;         //!< cloud cover
+    int32_t _cloud_target;  //!< cloud cover the weather tends to
+    int32_t _rain_rate;     //!< rain rate in um/h
+    uint32_t _rain_um;      //!< rain gauge
+    uint32_t _rain_acc;     //!< rain not yet accounted for in um*s/h
+    int32_t _wind_target;   //!< mean wind speed the weather tends to
+    int32_t _wind_avg;      //!< slowly changing mean wind speed
+    int32_t _wind_out;      //!< average wind speed incl. turbulence
+    int32_t _gust;          //!< wind gust speed
+    int32_t _wind_dir;      //!< wind direction
+    int32_t _dir_drift;     //!< wind direction drift in 0.1 deg/min
+    int32_t _lux;           //!< illuminance in lux
+    int32_t _uv;            //!< UV index in 0.1
+    int32_t _soil_temp;     //!< soil temperature
+    int32_t _soil_moist;    //!< soil moisture
+    int32_t _pm;            //!< PM2.5
+    int32_t _co2;           //!< CO2 in ppm
+    int32_t _hcho;          //!< HCHO in ppb
+    uint16_t _strikes;      //!< lightning strike counter
+    int16_t _distance;      //!< lightning distance in km
+    uint32_t _leak_s;       //!< remaining leakage alarm time in s
+
+    //! Value limited to lo...hi
+    static inline int32_t clamp(int32_t x, int32_t lo, int32_t hi)
+    {
+        return (x < lo) ? lo : (x > hi) ? hi : x;
+    }
+
+    //! Division rounded to nearest, ties away from zero
+    static int32_t divRound(int32_t x, int32_t d)
+    {
+        return (x < 0) ? -((-x + d / 2) / d) : (x + d / 2) / d;
+    }
+
+    //! Next pseudo random number (xorshift32)
+    inline uint32_t rand32(void)
+    {
+        _rng ^= _rng << 13;
+        _rng ^= _rng >> 17;
+        _rng ^= _rng << 5;
+        return _rng;
+    }
+
+    //! Random number in [-amplitude, amplitude] with triangular distribution
+    inline int32_t noise(int32_t amplitude)
+    {
+        uint32_t r = rand32();
+        int32_t n = (int32_t)(r & 0xFFFF) + (int32_t)(r >> 16) - 0xFFFF;
+        return (int64_t)n * amplitude / 0xFFFF;
+    }
+
+    //! Random event with mean time between events mean_s, evaluated for dt seconds
+    inline bool chance(uint32_t dt, uint32_t mean_s)
+    {
+        if (dt >= mean_s)
+        {
+            return true;
+        }
+        return rand32() < (uint32_t)((uint64_t)dt * UINT32_MAX / mean_s);
+    }
+
+    //! First order low pass - x approaches target with time constant tau_s
+    static inline void approach(int32_t &x, int32_t target, uint32_t dt, uint32_t tau_s)
+    {
+        x += (int64_t)(target - x) * dt / (tau_s + dt);
+    }
+
+    //! Sine in Q15, angle: full circle = 65536
+    static int32_t sin16(uint16_t angle)
+    {
+        // sin(i * 90deg / 16) in Q15
+        static const int16_t quarter[17] PROGMEM = {
+            0, 3212, 6393, 9512, 12540, 15447, 18205, 20788, 23170,
+            25330, 27246, 28899, 30274, 31357, 32138, 32610, 32767
+        };
+        uint16_t a = angle & 0x3FFF;
+        if (angle & 0x4000)
+        {
+            a = 0x4000 - a;
+        }
+        uint16_t i = a >> 10;
+        int32_t y0 = (int16_t)pgm_read_word(&quarter[i]);
+        int32_t y = y0;
+        if (i < 16)
+        {
+            int32_t y1 = (int16_t)pgm_read_word(&quarter[i + 1]);
+            y += ((y1 - y0) * (a & 0x3FF)) >> 10;
+        }
+        return (angle & 0x8000) ? -y : y;
+    }
+
+    //! Angle of time of day t shifted by offset_h hours
+    static inline uint16_t dayAngle(uint32_t t, uint8_t offset_h)
+    {
+        return ((t + 86400UL - offset_h * 3600UL) % 86400UL) * 65536ULL / 86400UL;
+    }
+
+    //! Advance state by dt seconds
+    void step(uint32_t dt)
+    {
+        uint32_t tod = _t_s % 86400UL;
+        int32_t sun = sin16(dayAngle(tod, 6));
+        if (sun < 0)
+        {
+            sun = 0;
+        }
+
+        // Weather regime
+        if (_raining)
+        {
+            if (chance(dt, 90 * 60))
+            {
+                _raining = false;
+                _storm = false;
+            }
+        }
+        else if (chance(dt, 12 * 3600UL))
+        {
+            _raining = true;
+            _storm = (rand32() & 3) == 0;
+            _rain_rate = 500 + rand32() % 4500;
+        }
+        if (chance(dt, 2 * 3600UL))
+        {
+            _cloud_target = rand32() & 0x7FFF;
+        }
+        approach(_cloud, _raining ? 31000 : _cloud_target, dt, 1800);
+
+        // Temperature - diurnal amplitude reduced by clouds
+        int32_t diurnal = (_temp_amp * sin16(dayAngle(tod, 9))) >> 15;
+        diurnal = (diurnal * (32768 - _cloud / 2)) >> 15;
+        approach(_temp_dev, noise(150), dt, 1800);
+        int32_t temp = _temp_mean + diurnal + _temp_dev - (_raining ? 200 : 0);
+        if (_started)
+        {
+            approach(_temp, temp, dt, 900);
+        }
+        else
+        {
+            _temp = temp;
+            _soil_temp = temp;
+        }
+
+        // Humidity - anti-correlated with temperature
+        approach(_hum_dev, noise(300), dt, 1800);
+        int32_t humidity = 6500 - (_temp - _temp_mean) * 5 / 2 + (_raining ? 2500 : 0) + _hum_dev;
+        humidity = clamp(humidity, 1500, 9900);
+        if (_started)
+        {
+            approach(_humidity, humidity, dt, 900);
+        }
+        else
+        {
+            _humidity = humidity;
+        }
+
+        // Wind
+        if (chance(dt, 3 * 3600UL))
+        {
+            _wind_target = 100 + rand32() % 500;
+        }
+        approach(_wind_avg, _wind_target + (_raining ? 200 : 0) + (_storm ? 600 : 0), dt, 1200);
+        _wind_out = _wind_avg + noise(_wind_avg / 5);
+        if (_wind_out < 0)
+        {
+            _wind_out = 0;
+        }
+        _gust = _wind_out + _wind_out * (30 + (int32_t)(rand32() % 60)) / 100;
+        approach(_dir_drift, noise(30), dt, 3600);
+        _wind_dir += _dir_drift * (int32_t)dt / 60 + noise(100);
+        _wind_dir %= 3600;
+        if (_wind_dir < 0)
+        {
+            _wind_dir += 3600;
+        }
+
+        // Rain gauge
+        uint32_t rain = 0;
+        if (_raining)
+        {
+            _rain_acc += _rain_rate * dt;
+            rain = _rain_acc / 3600;
+            _rain_acc %= 3600;
+            _rain_um += rain;
+        }
+
+        // Light and UV
+        int32_t clear = 32768 - (_cloud * 3 / 4);
+        _lux = ((int64_t)((sun * clear) >> 15) * 100000) >> 15;
+        _uv = ((((sun * sun) >> 15) * (32768 - (_cloud * 7 / 10))) >> 15) * 100 >> 15;
+
+        // Soil - 1 mm of rain adds 1 % moisture
+        approach(_soil_temp, _temp, dt, 6 * 3600UL);
+        if (rain)
+        {
+            _soil_moist += rain / 10;
+        }
+        else
+        {
+            approach(_soil_moist, 1500, dt, 3 * 86400UL);
+        }
+        _soil_moist = clamp(_soil_moist, 0, 10000);
+
+        // Air quality
+        approach(_pm, (_raining ? 50 : 150) + noise(50), dt, 7200);
+        bool occupied = (tod >= 7 * 3600UL) && (tod < 23 * 3600UL);
+        approach(_co2, (occupied ? 900 : 500) + noise(50), dt, 3600);
+        approach(_hcho, 20 + noise(10), dt, 3600);
+
+        // Lightning
+        if (_storm && chance(dt, 120))
+        {
+            _strikes = (_strikes + 1) % 1600;
+            _distance = clamp(_distance + noise(5), 1, 40);
+        }
+
+        // Leakage
+        _leak_s = (_leak_s > dt) ? _leak_s - dt : 0;
+        if (_leak_s == 0 && chance(dt, 86400UL))
+        {
+            _leak_s = 600;
+        }
+    }
+};
+
+#endif // WEATHER_GEN_H
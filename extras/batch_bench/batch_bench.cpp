@@ -0,0 +1,356 @@
+///////////////////////////////////////////////////////////////////////////////
+// batch_bench.cpp
+//
+// Host benchmark - batch encoding (SensorBatch.h) vs. encoding frame by frame
+//
+// For each encoder and for 1...100000 records, the throughput in frames/s
+// of both paths is measured:
+// - per-frame: encoder lookup, preamble/sync word and payload encoding into
+//   a message buffer, whitening and copying of the frame - as done in
+//   transmitFrame() - with the records stored as array of structures
+//   (like WeatherSensor::sensor)
+// - batch: encodeBatch() with the records stored as structure of arrays
+// Before the measurement, the output of both paths is compared.
+//
+// The frame assembly through FrameWriter (in place) is compared with the
+// previous path (header and payload in local arrays, copied into the message
+// buffer with memcpy()); the frames of both paths are compared as well.
+//
+// Finally, the cost per transmission of the 6-in-1 encoder is measured with
+// and without cached frames (Bresser6In1Frames).
+//
+// Build (Linux):
+//   g++ -std=c++17 -O2 -Wall -I../.. -o batch_bench batch_bench.cpp
+//   (in extras/batch_bench)
+//
+// Usage:
+//   batch_bench [<max_records>]
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          SensorRecord with scaled integers
+//          6-in-1: Cached frames are compared with encoding per transmission
+//          PRNG and time measurement from ../common/BenchHarness.h
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "SensorBatch.h"
+#include "FrameWriter.h"
+#include "../common/BenchHarness.h"
+
+#define MAX_RECORDS 100000      //!< max. number of records
+#define MIN_FRAMES  200000      //!< min. number of frames encoded per measurement
+#define MAX_FRAME_SIZE (FRAME_HEADER_SIZE + 26) //!< preamble, sync word and largest payload
+
+typedef SensorRecords<MAX_RECORDS> Records;
+
+//! Encoder under test
+struct Encoder {
+    const char *name;
+    uint8_t s_type;
+    uint8_t (*encode)(uint8_t *payload, const SensorRecord &rec);
+    size_t (*batch)(const Records &records, size_t first, size_t n, uint8_t *arena, size_t arena_size);
+    uint8_t size;
+    uint8_t whitening;
+};
+
+static const Encoder encoders[] = {
+    {"bresser-5in1", SENSOR_TYPE_WEATHER0, encodeBresser5In1<SensorRecord>,
+     encodeBatch<encodeBresser5In1<SensorRecord>, 26, 0, MAX_RECORDS>, 26, 0},
+    {"bresser-6in1", SENSOR_TYPE_WEATHER1, encodeBresser6In1Record,
+     encodeBatch<encodeBresser6In1Record, 18, 0, MAX_RECORDS>, 18, 0},
+    {"bresser-7in1", SENSOR_TYPE_WEATHER1, encodeBresser7In1<SensorRecord>,
+     encodeBatch<encodeBresser7In1<SensorRecord>, 26, WHITENING_BRESSER_7IN1, MAX_RECORDS>, 26, WHITENING_BRESSER_7IN1},
+    {"bresser-leakage", SENSOR_TYPE_LEAKAGE, encodeBresserLeakage<SensorRecord>,
+     encodeBatch<encodeBresserLeakage<SensorRecord>, 10, 0, MAX_RECORDS>, 10, 0},
+    {"bresser-lightning", SENSOR_TYPE_LIGHTNING, encodeBresserLightning<SensorRecord>,
+     encodeBatch<encodeBresserLightning<SensorRecord>, 10, WHITENING_BRESSER_LIGHTNING, MAX_RECORDS>, 10, WHITENING_BRESSER_LIGHTNING}
+};
+
+static XorShift32 rng;
+
+//! Generate plausible sensor data
+static void genRecord(SensorRecord &rec, uint32_t id, uint8_t s_type)
+{
+    memset(&rec, 0, sizeof(rec));
+    rec.sensor_id = id;
+    rec.s_type = s_type;
+    rec.startup = rng.uniform(0, 1) < 0.1f;
+    rec.battery_ok = rng.uniform(0, 1) < 0.9f;
+    rec.w.temp_c10 = rng.uniform(-200, 400);
+    rec.w.humidity = rng.uniform(10, 99);
+    rec.w.wind_gust_ms10 = rng.uniform(0, 300);
+    rec.w.wind_avg_ms10 = rec.w.wind_gust_ms10 * 6 / 10;
+    rec.w.wind_dir_deg10 = rng.uniform(0, 3599);
+    rec.w.rain_mm10 = rng.uniform(0, 99999);
+    rec.w.uv10 = rng.uniform(0, 120);
+    rec.w.light_lux = rng.uniform(0, 150000);
+    rec.lgt.strike_count = rng.uniform(0, 1599);
+    rec.lgt.distance_km = rng.uniform(0, 40);
+    rec.leak.alarm = rng.uniform(0, 1) < 0.5f;
+    rec.msg_type = id & 1;
+}
+
+//! Encode frames one by one - see transmitFrame()
+static size_t encodeFrames(const Encoder &enc, const std::vector<SensorRecord> &records, size_t n, uint8_t *out)
+{
+    size_t stride = FRAME_HEADER_SIZE + enc.size;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        uint8_t msg_buf[40];
+
+        // Encoder lookup by name
+        const Encoder *info = nullptr;
+        for (const Encoder &e : encoders)
+        {
+            if (strcmp(e.name, enc.name) == 0)
+            {
+                info = &e;
+                break;
+            }
+        }
+
+        memcpy(msg_buf, frame_header, FRAME_HEADER_SIZE);
+        memset(&msg_buf[FRAME_HEADER_SIZE], 0, info->size);
+        info->encode(&msg_buf[FRAME_HEADER_SIZE], records[i]);
+        if (info->whitening)
+        {
+            whiten(&msg_buf[FRAME_HEADER_SIZE], info->size, info->whitening);
+        }
+        memcpy(&out[i * stride], msg_buf, stride);
+    }
+    return n;
+}
+
+//! Frame assembly before FrameWriter - local arrays copied into the message buffer
+static size_t assembleMemcpy(const Encoder &enc, const SensorRecord &rec, uint8_t *msg)
+{
+    uint8_t preamble[] = {0xAA, 0xAA, 0xAA, 0xAA};
+    uint8_t syncword[] = {0x2D, 0xD4};
+    uint8_t payload[26];
+
+    memcpy(msg, preamble, sizeof(preamble));
+    memcpy(&msg[sizeof(preamble)], syncword, sizeof(syncword));
+    size_t size = sizeof(preamble) + sizeof(syncword);
+
+    memset(payload, 0, sizeof(payload));
+    enc.encode(payload, rec);
+    if (enc.whitening)
+    {
+        whiten(payload, enc.size, enc.whitening);
+    }
+    memcpy(&msg[size], payload, enc.size);
+    return size + enc.size;
+}
+
+//! Frame assembly with FrameWriter - see transmitFrame()
+static size_t assembleFrameWriter(const Encoder &enc, const SensorRecord &rec, uint8_t *msg)
+{
+    FrameWriter frame(msg, MAX_FRAME_SIZE);
+
+    frame.write(frame_header, FRAME_HEADER_SIZE);
+    uint8_t *payload = frame.reserve(enc.size);
+    enc.encode(payload, rec);
+    if (enc.whitening)
+    {
+        whiten(payload, enc.size, enc.whitening);
+    }
+    return frame.size();
+}
+
+//! Throughput in frames/s
+template <typename F>
+static double measure(size_t n, F encode)
+{
+    size_t reps = (n < MIN_FRAMES) ? MIN_FRAMES / n : 1;
+    return 1e9 / measureNs(n, reps, encode);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t max_records = (argc > 1) ? atol(argv[1]) : MAX_RECORDS;
+    if (max_records < 1 || max_records > MAX_RECORDS)
+    {
+        fprintf(stderr, "Number of records must be 1...%d!\n", MAX_RECORDS);
+        return 1;
+    }
+
+    Records *soa = new Records;
+    std::vector<SensorRecord> aos(max_records);
+    std::vector<uint8_t> out_frames(max_records * MAX_FRAME_SIZE);
+    std::vector<uint8_t> out_batch(max_records * MAX_FRAME_SIZE);
+
+    printf("%-18s %8s %16s %16s %8s\n", "Encoder", "Records", "Per-frame [1/s]", "Batch [1/s]", "Speedup");
+    for (const Encoder &enc : encoders)
+    {
+        rng.seed(1);
+        for (size_t i = 0; i < max_records; i++)
+        {
+            genRecord(aos[i], 0x10000 + i, enc.s_type);
+            soa->set(i, aos[i]);
+            soa->msg_type[i] = aos[i].msg_type;
+        }
+        soa->count = max_records;
+
+        // Both paths must provide identical frames
+        size_t n = max_records;
+        encodeFrames(enc, aos, n, out_frames.data());
+        enc.batch(*soa, 0, n, out_batch.data(), out_batch.size());
+        if (memcmp(out_frames.data(), out_batch.data(), n * (FRAME_HEADER_SIZE + enc.size)) != 0)
+        {
+            fprintf(stderr, "%s: frames differ!\n", enc.name);
+            return 1;
+        }
+
+        for (n = 1; n <= max_records; n *= 10)
+        {
+            double rate_frames = measure(n, [&]() { encodeFrames(enc, aos, n, out_frames.data()); });
+            double rate_batch = measure(n, [&]() { enc.batch(*soa, 0, n, out_batch.data(), out_batch.size()); });
+            printf("%-18s %8zu %16.0f %16.0f %8.2f\n", enc.name, n, rate_frames, rate_batch, rate_batch / rate_frames);
+        }
+    }
+
+    // Frame assembly - FrameWriter vs. memcpy()
+    // (even number of frames - 6-in-1 alternates between two message types)
+    const size_t n = (max_records < 1000) ? max_records & ~1UL : 1000;
+    printf("\nFrame assembly (%zu frames):\n", n);
+    printf("%-18s %16s %16s %8s\n", "Encoder", "memcpy [ns]", "FrameWriter [ns]", "Speedup");
+    for (const Encoder &enc : encoders)
+    {
+        rng.seed(1);
+        for (size_t i = 0; i < n; i++)
+        {
+            genRecord(aos[i], 0x10000 + i, enc.s_type);
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+            assembleMemcpy(enc, aos[i], &out_frames[i * MAX_FRAME_SIZE]);
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+            size_t size = assembleFrameWriter(enc, aos[i], &out_batch[i * MAX_FRAME_SIZE]);
+            if (size != (size_t)(FRAME_HEADER_SIZE + enc.size) ||
+                memcmp(&out_frames[i * MAX_FRAME_SIZE], &out_batch[i * MAX_FRAME_SIZE], size) != 0)
+            {
+                fprintf(stderr, "%s: frames differ!\n", enc.name);
+                return 1;
+            }
+        }
+        double rate_memcpy = measure(n, [&]() {
+            for (size_t i = 0; i < n; i++)
+            {
+                assembleMemcpy(enc, aos[i], &out_frames[i * MAX_FRAME_SIZE]);
+            }
+        });
+        double rate_writer = measure(n, [&]() {
+            for (size_t i = 0; i < n; i++)
+            {
+                assembleFrameWriter(enc, aos[i], &out_batch[i * MAX_FRAME_SIZE]);
+            }
+        });
+        printf("%-18s %16.1f %16.1f %8.2f\n", enc.name, 1e9 / rate_memcpy, 1e9 / rate_writer, rate_writer / rate_memcpy);
+    }
+
+    // 6-in-1 - encoding per transmission vs. cached frames of both message types
+    std::vector<Bresser6In1Frames<SensorRecord>> frames(n);
+    uint8_t payload[BRESSER_6IN1_SIZE];
+    uint8_t ref[BRESSER_6IN1_SIZE];
+    rng.seed(1);
+    for (size_t i = 0; i < n; i++)
+    {
+        genRecord(aos[i], 0x10000 + i, SENSOR_TYPE_WEATHER1);
+        aos[i].msg_type = BRESSER_6IN1_MSG_TEMP;
+    }
+
+    // Cached frames must be identical to encoding per transmission
+    for (int tx = 0; tx < 6; tx++)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            if (tx == 3)
+            {
+                aos[i].w.temp_c10++;
+                frames[i].invalidate();
+            }
+            memset(ref, 0, sizeof(ref));
+            encodeBresser6In1(ref, aos[i], aos[i].msg_type);
+            aos[i].msg_type ^= 1;
+            frames[i].encode(payload, aos[i]);
+            if (memcmp(ref, payload, sizeof(ref)) != 0)
+            {
+                fprintf(stderr, "bresser-6in1: cached frames differ!\n");
+                return 1;
+            }
+        }
+    }
+
+    double rate_encode = measure(n, [&]() {
+        for (size_t i = 0; i < n; i++)
+        {
+            memset(payload, 0, sizeof(payload));
+            encodeBresser6In1(payload, aos[i], aos[i].msg_type);
+            aos[i].msg_type ^= 1;
+        }
+    });
+    double rate_cached = measure(n, [&]() {
+        for (size_t i = 0; i < n; i++)
+        {
+            frames[i].encode(payload, aos[i]);
+        }
+    });
+    double rate_changed = measure(n, [&]() {
+        for (size_t i = 0; i < n; i++)
+        {
+            aos[i].w.rain_mm10++;
+            frames[i].invalidate();
+            frames[i].encode(payload, aos[i]);
+        }
+    });
+    printf("\n6-in-1 per transmission (%zu sensors, state %zu bytes/sensor):\n", n,
+           sizeof(Bresser6In1Frames<SensorRecord>));
+    printf("  %-32s %8.1f ns\n", "encoding", 1e9 / rate_encode);
+    printf("  %-32s %8.1f ns\n", "cached, data unchanged", 1e9 / rate_cached);
+    printf("  %-32s %8.1f ns\n", "cached, data changed", 1e9 / rate_changed);
+
+    delete soa;
+    return 0;
+}
@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+// BenchHarness.h
+//
+// Host benchmarks - pseudo random input data and time measurement
+//
+// Used by the benchmarks in ../batch_bench, ../json_filter_bench,
+// ../kernel_bench, ../layout_bench, ../task_bench and ../weather_bench.
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created from the benchmarks
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <chrono>
+
+/*!
+ * \brief xorshift32 PRNG
+ *
+ * Reproducible input data - the sequence only depends on the seed (not 0).
+ */
+class XorShift32 {
+public:
+    explicit XorShift32(uint32_t seed = 1) : state(seed)
+    {
+    }
+
+    void seed(uint32_t s)
+    {
+        state = s;
+    }
+
+    //! Next number
+    inline uint32_t next(void)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    //! Uniformly distributed number in [0, n)
+    inline uint32_t below(uint32_t n)
+    {
+        return next() % n;
+    }
+
+    //! Uniformly distributed number in [lo, hi]
+    inline float uniform(float lo, float hi)
+    {
+        return lo + (hi - lo) * (next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    uint32_t state;             //!< current state
+};
+
+/*!
+ * \brief Run time per item in ns
+ *
+ * \param items     number of items processed by one call of f
+ * \param reps      number of calls of f
+ * \param f         function under test
+ */
+template <typename F>
+double measureNs(uint64_t items, size_t reps, F f)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < reps; r++)
+    {
+        f();
+    }
+    std::chrono::duration<double, std::nano> t = std::chrono::steady_clock::now() - t0;
+    return t.count() / (items * reps);
+}
+
+/*!
+ * \brief Run time per item in ns - f is called until min_time has elapsed
+ *
+ * \param items     number of items processed by one call of f
+ * \param min_time  min. measurement time in s
+ * \param f         function under test
+ */
+template <typename F>
+double measureNsFor(uint64_t items, double min_time, F f)
+{
+    size_t reps = 0;
+    std::chrono::duration<double> t(0);
+    auto t0 = std::chrono::steady_clock::now();
+    do
+    {
+        f();
+        reps++;
+        t = std::chrono::steady_clock::now() - t0;
+    } while (t.count() < min_time);
+    return 1e9 * t.count() / (items * reps);
+}
+
+#endif // BENCH_HARNESS_H
@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////
+// WorkQueue.h
+//
+// Host tools - work queues with stealing for distributing work items
+// (indices 0...n-1) to all cores
+//
+// Used by ../digest_search/digest_search.cpp and ../farm_sim/farm_sim.cpp.
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created from digest_search.cpp and farm_sim.cpp
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef WORK_QUEUE_H
+#define WORK_QUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+
+/*!
+ * \brief Work queue with stealing
+ *
+ * Each thread owns a range of work item indices [begin, end), packed into
+ * one atomic word. The owner takes items from the front; idle threads steal
+ * the upper half of the largest remaining range of another thread.
+ */
+class WorkQueue {
+public:
+    void assign(uint32_t begin, uint32_t end)
+    {
+        _range.store(pack(begin, end));
+    }
+
+    bool pop(uint32_t &item)
+    {
+        uint64_t r = _range.load();
+        while (begin(r) < end(r))
+        {
+            if (_range.compare_exchange_weak(r, pack(begin(r) + 1, end(r))))
+            {
+                item = begin(r);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    uint32_t remaining(void) const
+    {
+        uint64_t r = _range.load();
+        return end(r) - begin(r);
+    }
+
+    //! Steal upper half of victim's range (own range must be empty)
+    bool steal(WorkQueue &victim)
+    {
+        uint64_t r = victim._range.load();
+        while (end(r) - begin(r) >= 2)
+        {
+            uint32_t mid = begin(r) + (end(r) - begin(r)) / 2;
+            if (victim._range.compare_exchange_weak(r, pack(begin(r), mid)))
+            {
+                _range.store(pack(mid, end(r)));
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static uint64_t pack(uint32_t begin, uint32_t end)
+    {
+        return (uint64_t)begin << 32 | end;
+    }
+    static uint32_t begin(uint64_t r)
+    {
+        return r >> 32;
+    }
+    static uint32_t end(uint64_t r)
+    {
+        return r & 0xFFFFFFFF;
+    }
+
+    std::atomic<uint64_t> _range{0};
+};
+
+/*!
+ * \brief Split work items [0, n) evenly among the queues
+ *
+ * \param queues    work queue per thread
+ * \param n         number of work items
+ */
+inline void assignWork(std::vector<WorkQueue> &queues, uint32_t n)
+{
+    size_t threads = queues.size();
+    for (size_t t = 0; t < threads; t++)
+    {
+        queues[t].assign((uint64_t)n * t / threads, (uint64_t)n * (t + 1) / threads);
+    }
+}
+
+/*!
+ * \brief Process work items of thread t until all queues are empty
+ *
+ * The own items are processed first; then items are stolen from the thread
+ * with the most remaining items.
+ *
+ * \param queues    work queue per thread
+ * \param t         thread index
+ * \param work      work item function
+ */
+template <typename F>
+void workLoop(std::vector<WorkQueue> &queues, unsigned t, F work)
+{
+    unsigned threads = queues.size();
+    uint32_t item;
+    for (;;)
+    {
+        while (queues[t].pop(item))
+        {
+            work(item);
+        }
+        unsigned victim = t;
+        uint32_t max = 0;
+        for (unsigned v = 0; v < threads; v++)
+        {
+            if (queues[v].remaining() > max)
+            {
+                max = queues[v].remaining();
+                victim = v;
+            }
+        }
+        if (max == 0)
+        {
+            break;
+        }
+        if (victim != t && !queues[t].steal(queues[victim]))
+        {
+            // Last item of the victim - try to take it
+            if (queues[victim].pop(item))
+            {
+                work(item);
+            }
+        }
+    }
+}
+
+#endif // WORK_QUEUE_H
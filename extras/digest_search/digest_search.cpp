@@ -0,0 +1,629 @@
+///////////////////////////////////////////////////////////////////////////////
+// digest_search.cpp
+//
+// Host tool - search for the digest/checksum parameters of captured payloads
+//
+// The captured payloads (golden vector corpus format, see extras/golden)
+// of one encoder are used to search the parameter space of
+// - LFSR digests (lfsr_digest16()): generator, key and final XOR
+// - CRC-16 (crc16()): polynomial, reflection, init and final XOR
+// - the byte range covered by the digest (first...last byte)
+// The digest is taken from payload bytes 0 and 1 (big endian, or little
+// endian with option -l).
+//
+// Both digests are linear in the payload data, so for two payloads of equal
+// length, the final XOR (and the CRC init) cancel out:
+//   digest(a) ^ digest(b) == digest'(a ^ b)
+// The search is done on the differences of reference payloads vs. the first
+// payload; the final XOR is derived from the first payload for each hit,
+// which then is verified against all payloads.
+//
+// - LFSR: For each generator and byte range, all 65536 keys are evaluated.
+//   The digest is linear in the key, too: the digests for the 16 unit keys
+//   are computed once, then the keys are enumerated in Gray code order in
+//   batches of 16 (vector lanes), i.e. one XOR per batch and reference.
+// - CRC: 16 polynomials are evaluated in parallel (vector lanes).
+// The work items (parameter/byte range combinations) are distributed to all
+// cores; idle threads steal half of the remaining items of other threads.
+//
+// Build (Linux):
+//   g++ -std=c++17 -O3 -march=native -Wall -pthread -I../.. -o digest_search digest_search.cpp
+//   (in extras/digest_search)
+//
+// Usage:
+//   digest_search [-x <encoder>] [-s <first_min>:<first_max>] [-e <last_min>:<last_max>]
+//                 [-w <whitening>] [-l] [-m <min_matches>] [-t <threads>] [<vectors_file>]
+//
+// Examples:
+//   Bresser 7-in-1 (whitened) - finds gen 0x8810, key 0xBA95, final XOR 0x6DF1, bytes 2...24:
+//     ./digest_search -x bresser-7in1 -w aa -s 2:2 -e 24:24
+//   Bresser Leakage - finds CRC-16 poly 0x1021, init 0x0000, final XOR 0x0000, bytes 2...6
+//   (and the equivalent LFSR digest):
+//     ./digest_search -s 2:4 -e 3:16
+//
+// The references are taken from the first payloads, i.e. these must not be corrupted.
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Moved work queue to ../common/WorkQueue.h
+//          BROADCAST() macro instead of function returning vector (-Wpsabi)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "PayloadEncoders.h"
+#include "../common/WorkQueue.h"
+
+#define MAX_PAYLOAD 26          //!< max. payload size
+#define LANES 16                //!< candidates per batch
+#define NUM_REFS 2              //!< reference differences evaluated per batch
+#define MAX_HITS 20             //!< max. number of hits printed per algorithm
+
+//! Batch of 16 candidates
+typedef uint16_t Lanes __attribute__((vector_size(2 * LANES)));
+
+//! Lane comparison result
+typedef int16_t LaneMask __attribute__((vector_size(2 * LANES)));
+
+//! Captured payload
+struct Frame {
+    uint8_t data[MAX_PAYLOAD];  //!< payload (de-whitened)
+    uint16_t digest;            //!< digest from bytes 0/1
+};
+
+//! Byte range covered by the digest
+struct Range {
+    uint8_t first;              //!< first byte
+    uint8_t len;                //!< number of bytes
+    uint8_t nrefs;              //!< number of reference differences
+    uint8_t delta[NUM_REFS][MAX_PAYLOAD]; //!< reference payload differences
+    uint16_t target[NUM_REFS];  //!< reference digest differences
+};
+
+//! Search result
+struct Hit {
+    const char *algo;
+    uint8_t first;
+    uint8_t last;
+    uint16_t param1;            //!< LFSR: generator / CRC: polynomial (normal representation)
+    uint16_t param2;            //!< LFSR: key / CRC: init (with final XOR 0)
+    uint16_t final_xor;         //!< final XOR (LFSR: with param2 / CRC: with init 0)
+    bool reflect;
+    int matches;
+};
+
+static std::vector<Frame> frames;
+static std::vector<Range> ranges;
+static std::vector<Hit> hits;
+static std::mutex hits_mutex;
+static int min_matches;
+
+/*!
+ * \brief Process work items [0, n) with all threads
+ *
+ * \param n         number of work items
+ * \param threads   number of threads
+ * \param work      work item function
+ */
+template <typename F>
+static void parallel(uint32_t n, unsigned threads, F work)
+{
+    std::vector<WorkQueue> queues(threads);
+    assignWork(queues, n);
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; t++)
+    {
+        pool.emplace_back([&, t]() { workLoop(queues, t, work); });
+    }
+    for (std::thread &th : pool)
+    {
+        th.join();
+    }
+}
+
+//! All lanes set to x (macro - vector arguments/return values give -Wpsabi warnings without AVX)
+#define BROADCAST(x) ((Lanes){} + (uint16_t)(x))
+
+//! Bit mask of lanes equal to reference targets
+static inline unsigned matchLanes(const Lanes *v, const uint16_t *target, int nrefs)
+{
+    LaneMask eq = (v[0] == BROADCAST(target[0]));
+    for (int r = 1; r < nrefs; r++)
+    {
+        eq &= (v[r] == BROADCAST(target[r]));
+    }
+    uint64_t w[4];
+    memcpy(w, &eq, sizeof(w));
+    if ((w[0] | w[1] | w[2] | w[3]) == 0)
+    {
+        return 0;
+    }
+    unsigned mask = 0;
+    for (int i = 0; i < LANES; i++)
+    {
+        if (eq[i])
+        {
+            mask |= 1U << i;
+        }
+    }
+    return mask;
+}
+
+static void addHit(const Hit &hit)
+{
+    std::lock_guard<std::mutex> lock(hits_mutex);
+    hits.push_back(hit);
+}
+
+//
+// LFSR digest
+//
+
+//! Verify LFSR candidate against all payloads
+static void verifyLfsr(const Range &r, uint16_t gen, uint16_t key)
+{
+    uint16_t final_xor = frames[0].digest ^ lfsr_digest16(&frames[0].data[r.first], r.len, gen, key);
+    int matches = 0;
+    for (const Frame &f : frames)
+    {
+        matches += ((lfsr_digest16(&f.data[r.first], r.len, gen, key) ^ final_xor) == f.digest);
+    }
+    if (matches >= min_matches)
+    {
+        addHit({"LFSR", r.first, (uint8_t)(r.first + r.len - 1), gen, key, final_xor, false, matches});
+    }
+}
+
+/*!
+ * \brief Evaluate all keys for one generator and byte range
+ *
+ * The digests of the reference differences for the 16 unit keys are
+ * computed in parallel (one key per lane). Then the keys are enumerated
+ * in Gray code order - bits 0...3 of the key select the lane, bits 4...15
+ * change by one bit from batch to batch.
+ */
+static void searchLfsr(const Range &r, uint16_t gen)
+{
+    static const Lanes unit = {1, 2, 4, 8, 0x10, 0x20, 0x40, 0x80,
+                               0x100, 0x200, 0x400, 0x800, 0x1000, 0x2000, 0x4000, 0x8000};
+    const Lanes gen_v = BROADCAST(gen);
+    uint16_t basis[NUM_REFS][16];
+    Lanes v[NUM_REFS];
+
+    for (int ref = 0; ref < r.nrefs; ref++)
+    {
+        Lanes key = unit;
+        Lanes sum = {};
+        for (int k = 0; k < r.len; k++)
+        {
+            uint8_t data = r.delta[ref][k];
+            for (int i = 7; i >= 0; i--)
+            {
+                if ((data >> i) & 1)
+                {
+                    sum ^= key;
+                }
+                key = (key >> 1) ^ (gen_v & -(key & 1));
+            }
+        }
+        memcpy(basis[ref], &sum, sizeof(basis[ref]));
+
+        // Keys 0...15
+        for (int l = 0; l < LANES; l++)
+        {
+            uint16_t x = 0;
+            for (int j = 0; j < 4; j++)
+            {
+                if ((l >> j) & 1)
+                {
+                    x ^= basis[ref][j];
+                }
+            }
+            v[ref][l] = x;
+        }
+    }
+
+    for (uint32_t i = 0;;)
+    {
+        unsigned mask = matchLanes(v, r.target, r.nrefs);
+        while (mask)
+        {
+            int l = __builtin_ctz(mask);
+            mask &= mask - 1;
+            verifyLfsr(r, gen, (uint16_t)(((i ^ (i >> 1)) << 4) | l));
+        }
+        if (++i == 4096)
+        {
+            break;
+        }
+        int j = 4 + __builtin_ctz(i);
+        for (int ref = 0; ref < r.nrefs; ref++)
+        {
+            v[ref] ^= BROADCAST(basis[ref][j]);
+        }
+    }
+}
+
+//
+// CRC-16
+//
+
+static uint16_t reverse16(uint16_t x)
+{
+    uint16_t y = 0;
+    for (int i = 0; i < 16; i++)
+    {
+        y = (y << 1) | ((x >> i) & 1);
+    }
+    return y;
+}
+
+//! Reflected CRC-16 (reflected polynomial)
+static uint16_t crc16r(uint8_t const message[], unsigned nBytes, uint16_t polynomial, uint16_t init)
+{
+    uint16_t remainder = init;
+    for (unsigned byte = 0; byte < nBytes; ++byte)
+    {
+        remainder ^= message[byte];
+        for (unsigned bit = 0; bit < 8; ++bit)
+        {
+            remainder = (remainder & 1) ? (remainder >> 1) ^ polynomial : (remainder >> 1);
+        }
+    }
+    return remainder;
+}
+
+static inline uint16_t crc(bool reflect, const uint8_t *msg, unsigned len, uint16_t poly, uint16_t init)
+{
+    return reflect ? crc16r(msg, len, reverse16(poly), init) : crc16(msg, len, poly, init);
+}
+
+//! Verify CRC candidate against all payloads
+static void verifyCrc(const Range &r, uint16_t poly, bool reflect)
+{
+    const uint8_t *msg0 = &frames[0].data[r.first];
+    uint16_t final_xor = frames[0].digest ^ crc(reflect, msg0, r.len, poly, 0);
+    int matches = 0;
+    for (const Frame &f : frames)
+    {
+        matches += ((crc(reflect, &f.data[r.first], r.len, poly, 0) ^ final_xor) == f.digest);
+    }
+    if (matches < min_matches)
+    {
+        return;
+    }
+
+    // Equivalent init value with final XOR 0 (if any)
+    uint32_t init = 0;
+    while (init <= 0xFFFF && crc(reflect, msg0, r.len, poly, init) != frames[0].digest)
+    {
+        init++;
+    }
+    addHit({"CRC", r.first, (uint8_t)(r.first + r.len - 1), poly, (uint16_t)init,
+            final_xor, reflect, (init <= 0xFFFF) ? matches : -matches});
+}
+
+//! Evaluate 16 polynomials for one byte range
+static void searchCrc(const Range &r, uint16_t poly_base, bool reflect)
+{
+    Lanes poly;
+    for (int l = 0; l < LANES; l++)
+    {
+        poly[l] = reflect ? reverse16(poly_base + l) : poly_base + l;
+    }
+
+    Lanes v[NUM_REFS] = {};
+    for (int ref = 0; ref < r.nrefs; ref++)
+    {
+        Lanes rem = {};
+        for (int k = 0; k < r.len; k++)
+        {
+            uint8_t data = r.delta[ref][k];
+            if (reflect)
+            {
+                rem ^= BROADCAST(data);
+                for (int i = 0; i < 8; i++)
+                {
+                    rem = (rem >> 1) ^ (poly & -(rem & 1));
+                }
+            }
+            else
+            {
+                rem ^= BROADCAST(data << 8);
+                for (int i = 0; i < 8; i++)
+                {
+                    rem = (rem << 1) ^ (poly & -(rem >> 15));
+                }
+            }
+        }
+        v[ref] = rem;
+    }
+
+    unsigned mask = matchLanes(v, r.target, r.nrefs);
+    while (mask)
+    {
+        int l = __builtin_ctz(mask);
+        mask &= mask - 1;
+        verifyCrc(r, poly_base + l, reflect);
+    }
+}
+
+//
+// Setup
+//
+
+//! Load payloads of encoder from corpus
+static bool load(const char *filename, const char *encoder, uint8_t whitening, bool little_endian)
+{
+    FILE *f = fopen(filename, "r");
+    if (!f)
+    {
+        perror(filename);
+        return false;
+    }
+
+    char line[512];
+    while (fgets(line, sizeof(line), f))
+    {
+        char name[32];
+        char hex[256];
+        if (line[0] == '#' || sscanf(line, "%31s %255s", name, hex) < 2 || strcmp(name, encoder) != 0)
+        {
+            continue;
+        }
+
+        Frame fr = {};
+        size_t n = std::min(strlen(hex) / 2, (size_t)MAX_PAYLOAD);
+        for (size_t i = 0; i < n; i++)
+        {
+            unsigned b;
+            sscanf(&hex[2 * i], "%2x", &b);
+            fr.data[i] = b ^ whitening;
+        }
+        fr.digest = little_endian ? (fr.data[1] << 8 | fr.data[0]) : (fr.data[0] << 8 | fr.data[1]);
+        frames.push_back(fr);
+    }
+    fclose(f);
+    return true;
+}
+
+/*!
+ * \brief Set up byte range with reference differences
+ *
+ * The references are the first payloads (after the first one) which differ
+ * from the first payload and from the previous reference within the range.
+ *
+ * \returns false if there are not enough distinct payloads
+ */
+static bool setupRange(Range &r, uint8_t first, uint8_t last)
+{
+    r.first = first;
+    r.len = last - first + 1;
+    r.nrefs = 0;
+
+    const uint8_t *msg0 = &frames[0].data[first];
+    for (size_t k = 1; k < frames.size() && r.nrefs < NUM_REFS; k++)
+    {
+        const uint8_t *msg = &frames[k].data[first];
+        if (memcmp(msg, msg0, r.len) == 0)
+        {
+            continue;
+        }
+        if (r.nrefs > 0 && memcmp(msg, &frames[k - 1].data[first], r.len) == 0)
+        {
+            continue;
+        }
+        for (int i = 0; i < r.len; i++)
+        {
+            r.delta[r.nrefs][i] = msg[i] ^ msg0[i];
+        }
+        r.target[r.nrefs] = frames[k].digest ^ frames[0].digest;
+        r.nrefs++;
+    }
+    return r.nrefs > 0;
+}
+
+static bool parseRange(const char *arg, int &lo, int &hi)
+{
+    return sscanf(arg, "%d:%d", &lo, &hi) == 2 && lo >= 0 && lo <= hi && hi < MAX_PAYLOAD;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *filename = "../golden/vectors.txt";
+    const char *encoder = "bresser-leakage";
+    int first_min = 2, first_max = 2;
+    int last_min = 3, last_max = 16;
+    uint8_t whitening = 0;
+    bool little_endian = false;
+    unsigned threads = std::max(1U, std::thread::hardware_concurrency());
+    min_matches = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_arg = (i + 1 < argc);
+        if (strcmp(argv[i], "-x") == 0 && has_arg)
+        {
+            encoder = argv[++i];
+        }
+        else if (strcmp(argv[i], "-s") == 0 && has_arg)
+        {
+            if (!parseRange(argv[++i], first_min, first_max))
+            {
+                fprintf(stderr, "Invalid range: %s\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-e") == 0 && has_arg)
+        {
+            if (!parseRange(argv[++i], last_min, last_max))
+            {
+                fprintf(stderr, "Invalid range: %s\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-w") == 0 && has_arg)
+        {
+            whitening = strtoul(argv[++i], nullptr, 16);
+        }
+        else if (strcmp(argv[i], "-l") == 0)
+        {
+            little_endian = true;
+        }
+        else if (strcmp(argv[i], "-m") == 0 && has_arg)
+        {
+            min_matches = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-t") == 0 && has_arg)
+        {
+            threads = std::max(1, atoi(argv[++i]));
+        }
+        else if (argv[i][0] == '-')
+        {
+            fprintf(stderr, "Usage: %s [-x <encoder>] [-s <first_min>:<first_max>] [-e <last_min>:<last_max>]\n"
+                            "       [-w <whitening>] [-l] [-m <min_matches>] [-t <threads>] [<vectors_file>]\n", argv[0]);
+            return 1;
+        }
+        else
+        {
+            filename = argv[i];
+        }
+    }
+
+    if (!load(filename, encoder, whitening, little_endian))
+    {
+        return 1;
+    }
+    if (frames.size() < 2)
+    {
+        fprintf(stderr, "At least two payloads of encoder '%s' are required!\n", encoder);
+        return 1;
+    }
+    if (min_matches <= 0 || min_matches > (int)frames.size())
+    {
+        min_matches = frames.size();
+    }
+
+    for (int first = first_min; first <= first_max; first++)
+    {
+        for (int last = std::max(first, last_min); last <= last_max; last++)
+        {
+            Range r;
+            if (setupRange(r, first, last))
+            {
+                ranges.push_back(r);
+            }
+        }
+    }
+    printf("Payloads: %zu (%s), byte ranges: %zu, min. matches: %d, threads: %u\n",
+           frames.size(), encoder, ranges.size(), min_matches, threads);
+    if (ranges.empty())
+    {
+        fprintf(stderr, "No byte range with distinct payloads!\n");
+        return 1;
+    }
+
+    // LFSR - work item: byte range x generator
+    auto t0 = std::chrono::steady_clock::now();
+    parallel(ranges.size() * 65536U, threads, [](uint32_t item) {
+        searchLfsr(ranges[item >> 16], item & 0xFFFF);
+    });
+    std::chrono::duration<double> t_lfsr = std::chrono::steady_clock::now() - t0;
+
+    // CRC - work item: byte range x reflection x 16 polynomials
+    t0 = std::chrono::steady_clock::now();
+    parallel(ranges.size() * 2 * 4096U, threads, [](uint32_t item) {
+        searchCrc(ranges[item / 8192], (item % 4096) * LANES, (item / 4096) & 1);
+    });
+    std::chrono::duration<double> t_crc = std::chrono::steady_clock::now() - t0;
+
+    std::sort(hits.begin(), hits.end(), [](const Hit &a, const Hit &b) {
+        return (a.matches != b.matches) ? abs(a.matches) > abs(b.matches) : a.last - a.first < b.last - b.first;
+    });
+    for (const char *algo : {"LFSR", "CRC"})
+    {
+        size_t n = 0;
+        for (const Hit &h : hits)
+        {
+            if (strcmp(h.algo, algo) != 0 || ++n > MAX_HITS)
+            {
+                continue;
+            }
+            if (h.algo[0] == 'L')
+            {
+                printf("LFSR bytes %2u...%2u: gen 0x%04X, key 0x%04X, final XOR 0x%04X - %d/%zu payloads\n",
+                       h.first, h.last, h.param1, h.param2, h.final_xor, h.matches, frames.size());
+            }
+            else if (h.matches > 0 && h.final_xor != 0)
+            {
+                printf("CRC  bytes %2u...%2u: poly 0x%04X%s, init 0x0000, final XOR 0x%04X (or init 0x%04X, final XOR 0x0000) - %d/%zu payloads\n",
+                       h.first, h.last, h.param1, h.reflect ? " reflected" : "", h.final_xor, h.param2, h.matches, frames.size());
+            }
+            else
+            {
+                printf("CRC  bytes %2u...%2u: poly 0x%04X%s, init 0x0000, final XOR 0x%04X - %d/%zu payloads\n",
+                       h.first, h.last, h.param1, h.reflect ? " reflected" : "", h.final_xor, abs(h.matches), frames.size());
+            }
+        }
+        if (n > MAX_HITS)
+        {
+            printf("%s: %zu more hits\n", algo, n - MAX_HITS);
+        }
+    }
+    if (hits.empty())
+    {
+        printf("No parameters found.\n");
+    }
+
+    // Candidates: LFSR generator x key, CRC polynomial x reflection (per byte range)
+    double n_lfsr = ranges.size() * 65536.0 * 65536.0;
+    double n_crc = ranges.size() * 2 * 65536.0;
+    printf("\nLFSR: %.3g candidates in %.2f s (%.3g candidates/s)\n", n_lfsr, t_lfsr.count(), n_lfsr / t_lfsr.count());
+    printf("CRC:  %.3g candidates in %.2f s (%.3g candidates/s)\n", n_crc, t_crc.count(), n_crc / t_crc.count());
+    printf("(final XOR and CRC init derived from the first payload)\n");
+
+    return hits.empty() ? 1 : 0;
+}
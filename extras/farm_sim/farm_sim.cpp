@@ -0,0 +1,825 @@
+///////////////////////////////////////////////////////////////////////////////
+// farm_sim.cpp
+//
+// Host tool - transmitter farm simulator
+//
+// Simulates a large number of emulated sensors (e.g. 10k...1M) and writes
+// their frames as one time-ordered stream - for testing receivers (e.g.
+// BresserWeatherSensorReceiver or rtl_433) at a scale far beyond the output
+// of a single board.
+//
+// Each sensor has an arrival process (TrafficModel.h, as in the sketch) and
+// slowly changing sensor data; the frames (preamble, sync word and payload)
+// are encoded by the encoders from PayloadEncoders.h.
+//
+// The simulated time is processed in epochs of EPOCH_MS. Within an epoch,
+// the sensors are split into work items of CHUNK sensors; each work item
+// produces the frames of its sensors in the epoch, sorted by time. The work
+// items are distributed to all worker threads; idle threads steal half of the
+// remaining items of other threads. The main thread merges the sorted frame
+// lists of the previous epoch with a k-way merge (binary heap over the work
+// items) into the output stream while the workers generate the next epoch.
+// The stream is ordered by time and sensor index, so it does not depend on
+// the number of threads (see checksum).
+//
+// Output (by file extension):
+// - .bin:          binary records: start time in ms (uint32_t, little endian),
+//                  frame size in bytes (uint8_t), frame
+// - .txt:          frame file for fsk_mod (start time in s and frame as hex
+//                  string per line)
+// - .cu8/.cs16:    I/Q samples (FskModulator.h); frames which overlap with
+//                  the previous frame are not rendered (collision)
+// Without -o, the stream is only merged and its checksum is computed.
+//
+// With option -b, the simulation is run with 1, 2, 4... threads up to
+// <threads> (without output) and the throughput and speedup are reported.
+//
+// Build (Linux):
+//   g++ -std=c++17 -O3 -march=native -Wall -pthread -I../.. -o farm_sim farm_sim.cpp
+//   (in extras/farm_sim)
+//
+// Usage:
+//   farm_sim [-x <encoder>|all] [-n <sensors>] [-i <interval_s>] [-m <traffic>[,<param>]]
+//            [-r <seed>] [-d <duration_s>] [-t <threads>] [-s <sample_rate>] [-b]
+//            [-o <out.bin|out.txt|out.cu8|out.cs16>]
+//
+// Examples:
+//   ./farm_sim -n 1000000 -d 600 -b
+//   ./farm_sim -x bresser-6in1 -n 20 -i 60 -m poisson -d 600 -o farm_250k.cu8
+//   rtl_433 -s 250k -r farm_250k.cu8
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Moved work queue to ../common/WorkQueue.h
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "SensorBatch.h"
+#include "TrafficModel.h"
+#include "../common/WorkQueue.h"
+#include "../fsk_mod/FskModulator.h"
+
+#define EPOCH_MS 1000           //!< simulated time per epoch in ms
+#define CHUNK 1024              //!< sensors per work item
+#define MAX_FRAME 32            //!< max. frame size in bytes (header + 26 bytes payload)
+
+//! Protocol
+struct Protocol {
+    const char *name;
+    uint8_t size;
+    uint8_t whitening;
+    uint8_t s_type;
+    uint8_t (*encode)(uint8_t *payload, const SensorRecord &rec);
+};
+
+static const Protocol protocols[] = {
+    {"bresser-5in1", 26, 0, SENSOR_TYPE_WEATHER0, encodeBresser5In1<SensorRecord>},
+    {"bresser-6in1", 18, 0, SENSOR_TYPE_WEATHER1, encodeBresser6In1Record},
+    {"bresser-7in1", 26, WHITENING_BRESSER_7IN1, SENSOR_TYPE_WEATHER1, encodeBresser7In1<SensorRecord>},
+    {"bresser-lightning", 10, WHITENING_BRESSER_LIGHTNING, SENSOR_TYPE_LIGHTNING, encodeBresserLightning<SensorRecord>},
+    {"bresser-leakage", 10, 0, SENSOR_TYPE_LEAKAGE, encodeBresserLeakage<SensorRecord>}
+};
+
+#define NUM_PROTOCOLS (sizeof(protocols) / sizeof(protocols[0]))
+
+static const char *const traffic_names[] = {"periodic", "jitter", "poisson", "burst"};
+
+//! Simulation parameters
+struct Config {
+    int protocol;               //!< index in protocols[] (-1: all, by sensor index)
+    uint32_t sensors;           //!< number of sensors
+    uint32_t interval_ms;       //!< mean transmit interval in ms
+    Traffic traffic;            //!< arrival process
+    uint16_t traffic_param;     //!< JITTER: max. deviation in ms, BURST: frames per burst
+    uint32_t seed;              //!< traffic model seed
+    uint32_t duration_ms;       //!< simulated time in ms
+};
+
+//! Emulated sensor
+struct Sensor {
+    TrafficModel traffic;       //!< arrival process state
+    uint32_t next_ms;           //!< start time of next frame
+    uint32_t count;             //!< number of frames transmitted
+    uint8_t protocol;           //!< index in protocols[]
+};
+
+//! Frame with start time
+struct Frame {
+    uint32_t t_ms;              //!< start time in ms
+    uint32_t sensor;            //!< sensor index
+    uint8_t len;                //!< frame size in bytes
+    uint8_t data[MAX_FRAME];    //!< frame
+};
+
+//! Sort key - time, then sensor index
+static inline uint64_t frameKey(const Frame &fr)
+{
+    return (uint64_t)fr.t_ms << 32 | fr.sensor;
+}
+
+/*!
+ * \brief Sensor farm
+ *
+ * The sensor state only depends on the sensor's own history, so the work
+ * items of an epoch can be generated in any order and by any thread.
+ */
+class Farm {
+public:
+    explicit Farm(const Config &cfg) : _cfg(cfg), _sensors(cfg.sensors)
+    {
+        for (uint32_t k = 0; k < cfg.sensors; k++)
+        {
+            Sensor &s = _sensors[k];
+            s.traffic.type = cfg.traffic;
+            s.traffic.param = cfg.traffic_param;
+            // TrafficModel::seed() takes a 16 bit index - the upper bits go into the seed
+            s.traffic.seed(cfg.seed + (k >> 16) * 0x632BE5ABUL, k & 0xFFFF);
+            s.next_ms = s.traffic.first(cfg.interval_ms, (uint64_t)k * cfg.interval_ms / cfg.sensors);
+            s.count = 0;
+            s.protocol = (cfg.protocol < 0) ? k % NUM_PROTOCOLS : cfg.protocol;
+        }
+    }
+
+    //! Number of work items
+    uint32_t chunks(void) const
+    {
+        return (_cfg.sensors + CHUNK - 1) / CHUNK;
+    }
+
+    /*!
+     * \brief Generate frames of one work item until end of epoch
+     *
+     * \param chunk     work item
+     * \param end_ms    end of epoch
+     * \param out       frames, sorted by time and sensor index
+     */
+    void generate(uint32_t chunk, uint32_t end_ms, std::vector<Frame> &out)
+    {
+        out.clear();
+        uint32_t last = std::min(_cfg.sensors, (chunk + 1) * CHUNK);
+        for (uint32_t k = chunk * CHUNK; k < last; k++)
+        {
+            Sensor &s = _sensors[k];
+            while (s.next_ms < end_ms)
+            {
+                out.emplace_back();
+                encode(out.back(), k, s);
+                s.count++;
+                s.next_ms += s.traffic.next(_cfg.interval_ms);
+            }
+        }
+        std::sort(out.begin(), out.end(), [](const Frame &a, const Frame &b) {
+            return frameKey(a) < frameKey(b);
+        });
+    }
+
+private:
+    //! Encode frame of sensor k with slowly changing values
+    static void encode(Frame &fr, uint32_t k, const Sensor &s)
+    {
+        const Protocol &p = protocols[s.protocol];
+        uint32_t m = s.count;
+        SensorRecord rec = {};
+        rec.sensor_id = 0x10000 + k;
+        rec.s_type = p.s_type;
+        rec.chan = k % 8;
+        rec.startup = (m == 0);
+        rec.battery_ok = true;
+        rec.msg_type = m & 1;
+        rec.w.temp_c10 = 100 + (m + k) % 150;
+        rec.w.humidity = 40 + (m + k) % 50;
+        rec.w.wind_gust_ms10 = (3 * m + k) % 200;
+        rec.w.wind_avg_ms10 = (2 * m + k) % 100;
+        rec.w.wind_dir_deg10 = (m * 7 + k * 45) % 360 * 10;
+        rec.w.rain_mm10 = m;
+        rec.w.uv10 = m % 120;
+        rec.w.light_lux = 500 * (m % 200);
+        rec.lgt.strike_count = m / 10;
+        rec.lgt.distance_km = 1 + (m + k) % 40;
+        rec.leak.alarm = (m % 10) == 0;
+
+        fr.t_ms = s.next_ms;
+        fr.sensor = k;
+        fr.len = FRAME_HEADER_SIZE + p.size;
+        memcpy(fr.data, frame_header, FRAME_HEADER_SIZE);
+        p.encode(&fr.data[FRAME_HEADER_SIZE], rec);
+        if (p.whitening)
+        {
+            whiten(&fr.data[FRAME_HEADER_SIZE], p.size, p.whitening);
+        }
+    }
+
+    const Config &_cfg;
+    std::vector<Sensor> _sensors;
+};
+
+/*!
+ * \brief Worker threads - generate the work items of one epoch at a time
+ *
+ * The threads are started once and wait for the next epoch between epochs.
+ */
+class Workers {
+public:
+    Workers(Farm &farm, unsigned threads) : _farm(farm), _queues(threads)
+    {
+        for (unsigned t = 0; t < threads; t++)
+        {
+            _pool.emplace_back([this, t]() {
+                run(t);
+            });
+        }
+    }
+
+    ~Workers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _start.notify_all();
+        for (std::thread &th : _pool)
+        {
+            th.join();
+        }
+    }
+
+    //! Start generation of epoch ending at end_ms into out[] (one list per work item)
+    void start(uint32_t end_ms, std::vector<std::vector<Frame>> &out)
+    {
+        assignWork(_queues, _farm.chunks());
+        std::lock_guard<std::mutex> lock(_mutex);
+        _end_ms = end_ms;
+        _out = &out;
+        _busy = _queues.size();
+        _epoch++;
+        _start.notify_all();
+    }
+
+    //! Wait until all work items of the epoch are done
+    void wait(void)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this]() {
+            return _busy == 0;
+        });
+    }
+
+private:
+    void run(unsigned t)
+    {
+        uint32_t epoch = 0;
+        for (;;)
+        {
+            uint32_t end_ms;
+            std::vector<std::vector<Frame>> *out;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _start.wait(lock, [&]() {
+                    return _stop || _epoch != epoch;
+                });
+                if (_stop)
+                {
+                    return;
+                }
+                epoch = _epoch;
+                end_ms = _end_ms;
+                out = _out;
+            }
+
+            workLoop(_queues, t, [&](uint32_t item) {
+                _farm.generate(item, end_ms, (*out)[item]);
+            });
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (--_busy == 0)
+            {
+                _done.notify_one();
+            }
+        }
+    }
+
+    Farm &_farm;
+    std::vector<WorkQueue> _queues;
+    std::vector<std::thread> _pool;
+    std::mutex _mutex;
+    std::condition_variable _start;
+    std::condition_variable _done;
+    uint32_t _epoch = 0;
+    uint32_t _end_ms = 0;
+    std::vector<std::vector<Frame>> *_out = nullptr;
+    unsigned _busy = 0;
+    bool _stop = false;
+};
+
+/*!
+ * \brief Binary min-heap for k-way merge
+ *
+ * Entries: sort key of the next frame and index of its source list.
+ */
+class MergeHeap {
+public:
+    struct Entry {
+        uint64_t key;
+        uint32_t src;
+    };
+
+    void clear(void)
+    {
+        _heap.clear();
+    }
+
+    bool empty(void) const
+    {
+        return _heap.empty();
+    }
+
+    const Entry &top(void) const
+    {
+        return _heap[0];
+    }
+
+    void push(uint64_t key, uint32_t src)
+    {
+        size_t i = _heap.size();
+        _heap.push_back({key, src});
+        while (i > 0 && _heap[(i - 1) / 2].key > key)
+        {
+            _heap[i] = _heap[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        _heap[i] = {key, src};
+    }
+
+    //! Replace key of top entry (next frame of the same source)
+    void replaceTop(uint64_t key)
+    {
+        siftDown({key, _heap[0].src});
+    }
+
+    void pop(void)
+    {
+        Entry last = _heap.back();
+        _heap.pop_back();
+        if (!_heap.empty())
+        {
+            siftDown(last);
+        }
+    }
+
+private:
+    void siftDown(Entry e)
+    {
+        size_t n = _heap.size();
+        size_t i = 0;
+        for (;;)
+        {
+            size_t c = 2 * i + 1;
+            if (c >= n)
+            {
+                break;
+            }
+            if (c + 1 < n && _heap[c + 1].key < _heap[c].key)
+            {
+                c++;
+            }
+            if (_heap[c].key >= e.key)
+            {
+                break;
+            }
+            _heap[i] = _heap[c];
+            i = c;
+        }
+        _heap[i] = e;
+    }
+
+    std::vector<Entry> _heap;
+};
+
+//! Output format
+enum struct Output {
+    NONE,
+    BIN,
+    TXT,
+    CU8,
+    CS16
+};
+
+/*!
+ * \brief Frame stream sink - output file and checksum
+ */
+class Sink {
+public:
+    Sink(FILE *out, Output format, double sample_rate)
+        : _out(out), _format(format), _sample_rate(sample_rate), _frames(0), _bytes(0), _skipped(0),
+          _hash(0xCBF29CE484222325ULL)
+    {
+        if (format == Output::CU8 || format == Output::CS16)
+        {
+            _mod = new FskModulator(out, (format == Output::CU8) ? Format::CU8 : Format::CS16, sample_rate, 0, 0.9f);
+        }
+        else
+        {
+            _mod = nullptr;
+        }
+    }
+
+    ~Sink()
+    {
+        delete _mod;
+    }
+
+    void write(const Frame &fr)
+    {
+        _frames++;
+        _bytes += fr.len;
+        // FNV-1a 64 over start time and frame
+        hash(reinterpret_cast<const uint8_t *>(&fr.t_ms), sizeof(fr.t_ms));
+        hash(fr.data, fr.len);
+
+        switch (_format)
+        {
+        case Output::BIN:
+            fwrite(&fr.t_ms, sizeof(fr.t_ms), 1, _out);
+            fwrite(&fr.len, 1, 1, _out);
+            fwrite(fr.data, 1, fr.len, _out);
+            break;
+
+        case Output::TXT:
+            fprintf(_out, "%u.%03u ", fr.t_ms / 1000, fr.t_ms % 1000);
+            for (uint8_t i = 0; i < fr.len; i++)
+            {
+                fprintf(_out, "%02X", fr.data[i]);
+            }
+            fputc('\n', _out);
+            break;
+
+        case Output::CU8:
+        case Output::CS16:
+        {
+            uint64_t start = (uint64_t)llround(fr.t_ms * _sample_rate / 1000);
+            if (start < _mod->samples())
+            {
+                _skipped++;
+                break;
+            }
+            _mod->idleUntil(start);
+            _mod->frame(fr.data, fr.len);
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    //! Idle (IQ output) until end of simulated time
+    void finish(uint32_t duration_ms)
+    {
+        if (_mod)
+        {
+            _mod->idleUntil(std::max((uint64_t)llround(duration_ms * _sample_rate / 1000), _mod->samples()));
+        }
+    }
+
+    uint64_t frames(void) const
+    {
+        return _frames;
+    }
+
+    uint64_t bytes(void) const
+    {
+        return _bytes;
+    }
+
+    //! Frames not rendered due to overlap (IQ output)
+    uint64_t skipped(void) const
+    {
+        return _skipped;
+    }
+
+    uint64_t checksum(void) const
+    {
+        return _hash;
+    }
+
+private:
+    void hash(const uint8_t *p, size_t len)
+    {
+        for (size_t i = 0; i < len; i++)
+        {
+            _hash = (_hash ^ p[i]) * 0x100000001B3ULL;
+        }
+    }
+
+    FILE *_out;
+    Output _format;
+    double _sample_rate;
+    FskModulator *_mod;
+    uint64_t _frames;
+    uint64_t _bytes;
+    uint64_t _skipped;
+    uint64_t _hash;
+};
+
+//! Run time of a simulation
+struct Timing {
+    double total;               //!< wall clock time in s
+    double merge;               //!< merge and output (main thread) in s
+};
+
+/*!
+ * \brief Run simulation
+ *
+ * The main thread merges epoch e - 1 while the workers generate epoch e
+ * (two sets of frame lists).
+ */
+static Timing simulate(const Config &cfg, unsigned threads, Sink &sink)
+{
+    Farm farm(cfg);
+    std::vector<std::vector<Frame>> lists[2];
+    lists[0].resize(farm.chunks());
+    lists[1].resize(farm.chunks());
+    std::vector<size_t> pos(farm.chunks());
+    MergeHeap heap;
+    std::chrono::duration<double> t_merge(0);
+
+    auto merge = [&](std::vector<std::vector<Frame>> &in) {
+        auto t0 = std::chrono::steady_clock::now();
+        heap.clear();
+        for (uint32_t c = 0; c < in.size(); c++)
+        {
+            pos[c] = 0;
+            if (!in[c].empty())
+            {
+                heap.push(frameKey(in[c][0]), c);
+            }
+        }
+        while (!heap.empty())
+        {
+            uint32_t c = heap.top().src;
+            sink.write(in[c][pos[c]]);
+            if (++pos[c] < in[c].size())
+            {
+                heap.replaceTop(frameKey(in[c][pos[c]]));
+            }
+            else
+            {
+                heap.pop();
+            }
+        }
+        t_merge += std::chrono::steady_clock::now() - t0;
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    {
+        Workers workers(farm, threads);
+        uint32_t epochs = (cfg.duration_ms + EPOCH_MS - 1) / EPOCH_MS;
+        for (uint32_t e = 0; e < epochs; e++)
+        {
+            workers.start(std::min(cfg.duration_ms, (e + 1) * EPOCH_MS), lists[e & 1]);
+            if (e > 0)
+            {
+                merge(lists[(e - 1) & 1]);
+            }
+            workers.wait();
+        }
+        if (epochs > 0)
+        {
+            merge(lists[(epochs - 1) & 1]);
+        }
+    }
+    sink.finish(cfg.duration_ms);
+    std::chrono::duration<double> t = std::chrono::steady_clock::now() - t0;
+    return {t.count(), t_merge.count()};
+}
+
+int main(int argc, char *argv[])
+{
+    Config cfg = {-1, 100000, 30000, Traffic::PERIODIC, 0, 1, 600000};
+    unsigned threads = std::max(1U, std::thread::hardware_concurrency());
+    double sample_rate = 250000;
+    bool bench = false;
+    const char *out_name = nullptr;
+    bool usage = false;
+
+    for (int i = 1; i < argc && !usage; i++)
+    {
+        bool has_arg = (i + 1 < argc);
+        if (strcmp(argv[i], "-x") == 0 && has_arg)
+        {
+            const char *name = argv[++i];
+            cfg.protocol = -2;
+            if (strcmp(name, "all") == 0)
+            {
+                cfg.protocol = -1;
+            }
+            for (size_t p = 0; p < NUM_PROTOCOLS; p++)
+            {
+                if (strcmp(name, protocols[p].name) == 0)
+                {
+                    cfg.protocol = p;
+                }
+            }
+            if (cfg.protocol == -2)
+            {
+                fprintf(stderr, "Unknown encoder '%s'!\n", name);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-n") == 0 && has_arg)
+        {
+            cfg.sensors = std::max(1L, atol(argv[++i]));
+        }
+        else if (strcmp(argv[i], "-i") == 0 && has_arg)
+        {
+            cfg.interval_ms = std::max(1.0, atof(argv[++i]) * 1000);
+        }
+        else if (strcmp(argv[i], "-m") == 0 && has_arg)
+        {
+            char *param = strchr(argv[++i], ',');
+            size_t len = param ? (size_t)(param - argv[i]) : strlen(argv[i]);
+            usage = true;
+            for (uint8_t t = 0; t < 4; t++)
+            {
+                if (strlen(traffic_names[t]) == len && strncmp(argv[i], traffic_names[t], len) == 0)
+                {
+                    cfg.traffic = static_cast<Traffic>(t);
+                    usage = false;
+                }
+            }
+            if (param)
+            {
+                cfg.traffic_param = atoi(param + 1);
+            }
+        }
+        else if (strcmp(argv[i], "-r") == 0 && has_arg)
+        {
+            cfg.seed = strtoul(argv[++i], nullptr, 0);
+        }
+        else if (strcmp(argv[i], "-d") == 0 && has_arg)
+        {
+            cfg.duration_ms = atof(argv[++i]) * 1000;
+        }
+        else if (strcmp(argv[i], "-t") == 0 && has_arg)
+        {
+            threads = std::max(1, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "-s") == 0 && has_arg)
+        {
+            sample_rate = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-b") == 0)
+        {
+            bench = true;
+        }
+        else if (strcmp(argv[i], "-o") == 0 && has_arg)
+        {
+            out_name = argv[++i];
+        }
+        else
+        {
+            usage = true;
+        }
+    }
+
+    if (usage || cfg.duration_ms == 0 || sample_rate < 4 * TX_DEVIATION)
+    {
+        fprintf(stderr, "Usage: %s [-x <encoder>|all] [-n <sensors>] [-i <interval_s>] [-m <traffic>[,<param>]]\n"
+                        "          [-r <seed>] [-d <duration_s>] [-t <threads>] [-s <sample_rate>] [-b]\n"
+                        "          [-o <out.bin|out.txt|out.cu8|out.cs16>]\n", argv[0]);
+        return 1;
+    }
+    if (cfg.traffic == Traffic::BURST && cfg.traffic_param == 0)
+    {
+        cfg.traffic_param = 3;
+    }
+
+    Output format = Output::NONE;
+    if (out_name)
+    {
+        const char *ext = strrchr(out_name, '.');
+        ext = ext ? ext : "";
+        format = (strcmp(ext, ".bin") == 0)  ? Output::BIN
+               : (strcmp(ext, ".txt") == 0)  ? Output::TXT
+               : (strcmp(ext, ".cu8") == 0)  ? Output::CU8
+               : (strcmp(ext, ".cs16") == 0) ? Output::CS16
+                                             : Output::NONE;
+        if (format == Output::NONE)
+        {
+            fprintf(stderr, "Output file extension must be .bin, .txt, .cu8 or .cs16!\n");
+            return 1;
+        }
+    }
+
+    printf("Sensors: %u (%s), interval: %.1f s, traffic: %s, duration: %.1f s, work items: %u x %u sensors\n",
+           cfg.sensors, (cfg.protocol < 0) ? "all encoders" : protocols[cfg.protocol].name,
+           cfg.interval_ms / 1000.0, traffic_names[static_cast<uint8_t>(cfg.traffic)], cfg.duration_ms / 1000.0,
+           (cfg.sensors + CHUNK - 1) / CHUNK, CHUNK);
+
+    if (bench)
+    {
+        printf("\nThreads   Time [s]    Frames/s   Speedup  Efficiency  Merge [%%]  Checksum\n");
+        double t1 = 0;
+        uint64_t checksum = 0;
+        bool same = true;
+        for (unsigned t = 1;; t = std::min(2 * t, threads))
+        {
+            Sink sink(nullptr, Output::NONE, sample_rate);
+            Timing timing = simulate(cfg, t, sink);
+            if (t == 1)
+            {
+                t1 = timing.total;
+                checksum = sink.checksum();
+            }
+            same &= (sink.checksum() == checksum);
+            printf("%7u %10.3f %11.4g %9.2f %10.0f%% %10.0f  %016llX\n", t, timing.total,
+                   sink.frames() / timing.total, t1 / timing.total, 100 * t1 / timing.total / t,
+                   100 * timing.merge / timing.total, (unsigned long long)sink.checksum());
+            if (t == threads)
+            {
+                break;
+            }
+        }
+        printf("\nHardware threads: %u, stream %s for all thread counts\n",
+               std::thread::hardware_concurrency(), same ? "identical" : "DIFFERS");
+        return same ? 0 : 1;
+    }
+
+    FILE *out = nullptr;
+    if (out_name && !(out = fopen(out_name, "wb")))
+    {
+        perror(out_name);
+        return 1;
+    }
+    Timing timing;
+    uint64_t frames, bytes, skipped, checksum;
+    {
+        Sink sink(out, format, sample_rate);
+        timing = simulate(cfg, threads, sink);
+        frames = sink.frames();
+        bytes = sink.bytes();
+        skipped = sink.skipped();
+        checksum = sink.checksum();
+    }
+    if (out)
+    {
+        fclose(out);
+    }
+
+    // Offered load: sum of frame airtimes / simulated time
+    double load = bytes * 8 / (TX_BITRATE / 1000) / cfg.duration_ms;
+    printf("Frames:  %llu, offered load %.3g Erlang (pure ALOHA collision probability %.3g)\n",
+           (unsigned long long)frames, load, collisionProbability(load));
+    if (format == Output::CU8 || format == Output::CS16)
+    {
+        printf("IQ:      %llu frames not rendered due to overlap\n", (unsigned long long)skipped);
+    }
+    printf("Threads: %u, time %.3f s, %.4g frames/s (%.0fx real time), merge/output %.0f%%\n",
+           threads, timing.total, frames / timing.total, cfg.duration_ms / 1000.0 / timing.total,
+           100 * timing.merge / timing.total);
+    printf("Checksum: %016llX\n", (unsigned long long)checksum);
+    return 0;
+}
@@ -0,0 +1,192 @@
+///////////////////////////////////////////////////////////////////////////////
+// fleet_image.cpp
+//
+// Host tool - persistent fleet configuration image (FleetImage.h)
+//
+// Writes an image with <sensors> emulated sensors with own data and a JSON
+// string to <file> - the file corresponds to the file FLEET_IMAGE in LittleFS
+// on the target, with SensorRecord (PayloadEncoders.h) as sensor data record.
+// Then the image is loaded from the file repeatedly - like configLoad() with
+// a single read and the check of header and CRC - and the load time is
+// reported (read and check separately; the file is in the page cache after the
+// first read).
+// Finally, the check is verified to reject every single bit error, truncated
+// images and images with a different layout version.
+//
+// Build (Linux):
+//   g++ -std=c++17 -O2 -Wall -I../.. -o fleet_image fleet_image.cpp
+//   (in extras/fleet_image)
+//
+// Usage:
+//   fleet_image [<file> [<sensors>]]
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          SensorRecord with scaled integers
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+
+#include "SensorBatch.h"
+#include "FleetImage.h"
+
+#define MAX_FLEET_SIZE  32      //!< max. number of emulated sensors (see SensorTransmitter.h)
+#define MAX_LINE_LENGTH 2048    //!< max. length of JSON string (see SensorTransmitter.h)
+#define LOADS           10000   //!< number of loads measured
+
+typedef FleetImage<SensorRecord, MAX_FLEET_SIZE, MAX_LINE_LENGTH + 1> FleetConfig;
+
+static const char json_default[] =
+    "{\"sensor_id\":12345678,\"s_type\":1,\"chan\":0,\"startup\":0,\"battery_ok\":1,\"temp_c\":12.3,"
+    "\"humidity\":44,\"wind_gust_meter_sec\":3.3,\"wind_avg_meter_sec\":2.2,\"wind_direction_deg\":111.1,"
+    "\"rain_mm\":123.4}";
+
+//! Load image from file - single read
+static size_t load(const char *name, FleetConfig *img)
+{
+    FILE *f = fopen(name, "rb");
+    if (!f)
+    {
+        return 0;
+    }
+    size_t len = fread(img, 1, sizeof(FleetConfig), f);
+    fclose(f);
+    return len;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *name = (argc > 1) ? argv[1] : "fleet.bin";
+    int sensors = (argc > 2) ? atoi(argv[2]) : MAX_FLEET_SIZE;
+    if (sensors < 1 || sensors > MAX_FLEET_SIZE)
+    {
+        fprintf(stderr, "Number of sensors must be 1...%d!\n", MAX_FLEET_SIZE);
+        return 1;
+    }
+
+    // CRC-32 check value
+    if (crc32(reinterpret_cast<const uint8_t *>("123456789"), 9) != 0xCBF43926UL)
+    {
+        fprintf(stderr, "CRC-32 check value mismatch!\n");
+        return 1;
+    }
+
+    FleetConfig *img = new FleetConfig;
+    memset(img, 0, sizeof(FleetConfig));
+    img->tx_interval = 30;
+    img->traffic_seed = 1;
+    img->encoder = 2;
+    img->fleet_size = sensors;
+    for (int i = 0; i < sensors; i++)
+    {
+        SensorRecord &s = img->slot[i].sensor;
+        s.sensor_id = 0x10000 + i;
+        s.s_type = SENSOR_TYPE_WEATHER1;
+        s.battery_ok = true;
+        s.w.temp_c10 = -200 + i * 5;
+        s.w.humidity = 30 + i;
+        s.w.rain_mm10 = i * 100;
+        img->slot[i].traffic_param = 500;
+        img->slot[i].traffic = 1;
+        img->slot[i].encoder = i % 5;
+        img->slot[i].own_data = 1;
+    }
+    size_t size = img->seal(json_default, strlen(json_default));
+
+    FILE *f = fopen(name, "wb");
+    if (!f || fwrite(img, 1, size, f) != size)
+    {
+        fprintf(stderr, "Writing %s failed!\n", name);
+        return 1;
+    }
+    fclose(f);
+    printf("Image:  %s, %zu bytes (%zu bytes fixed, %d bytes JSON), %d sensors, record %zu bytes\n",
+           name, size, img->fixedSize(), img->json_len, sensors, sizeof(SensorRecord));
+
+    // Load time
+    FleetConfig *in = new FleetConfig;
+    double t_read = 0;
+    double t_check = 0;
+    for (int i = 0; i < LOADS; i++)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        size_t len = load(name, in);
+        auto t1 = std::chrono::steady_clock::now();
+        bool ok = in->check(len);
+        auto t2 = std::chrono::steady_clock::now();
+        if (!ok || memcmp(in, img, size) != 0)
+        {
+            fprintf(stderr, "Image read back differs!\n");
+            return 1;
+        }
+        t_read += std::chrono::duration<double>(t1 - t0).count();
+        t_check += std::chrono::duration<double>(t2 - t1).count();
+    }
+    printf("Load:   %.2f us (read %.2f us, check %.2f us = %.2f ns/byte), mean of %d loads\n",
+           (t_read + t_check) / LOADS * 1e6, t_read / LOADS * 1e6, t_check / LOADS * 1e6,
+           t_check / LOADS * 1e9 / size, LOADS);
+
+    // Corrupted images
+    size_t rejected = 0;
+    for (size_t bit = 0; bit < size * 8; bit++)
+    {
+        memcpy(in, img, size);
+        reinterpret_cast<uint8_t *>(in)[bit / 8] ^= 1 << (bit % 8);
+        rejected += !in->check(size);
+    }
+    printf("Check:  %zu/%zu single bit errors rejected", rejected, size * 8);
+
+    size_t truncated = 0;
+    for (size_t len = 0; len < size; len++)
+    {
+        memcpy(in, img, size);
+        truncated += !in->check(len);
+    }
+    printf(", %zu/%zu truncated images rejected", truncated, size);
+
+    memcpy(in, img, size);
+    in->hdr.version++;
+    printf(", other version %s\n", in->check(size) ? "accepted!" : "rejected");
+
+    bool pass = (rejected == size * 8) && (truncated == size) && !in->check(size);
+    delete in;
+    delete img;
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,251 @@
+///////////////////////////////////////////////////////////////////////////////
+// FskModulator.h
+//
+// Host tools - streaming continuous phase 2-FSK baseband modulator
+//
+// Encoded frames are modulated with the bit rate and deviation of the
+// transmitter (8.21 kbps, 57.136 kHz, as configured in setup()) into complex
+// baseband samples, which are written as .cu8 (8 bit unsigned I/Q, like
+// rtl_sdr) or .cs16 (16 bit signed I/Q). The numerically controlled
+// oscillator uses a 32 bit phase accumulator; 8 samples are computed at once
+// with GCC vector extensions.
+//
+// Used by fsk_mod.cpp and ../farm_sim/farm_sim.cpp.
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created from fsk_mod.cpp
+//          sinPhase(): vectors by reference (-Wpsabi)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef FSK_MODULATOR_H
+#define FSK_MODULATOR_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+#define TX_BITRATE 8210.0       //!< bit rate in bps (see SensorTransmitter.h)
+#define TX_DEVIATION 57136.417  //!< frequency deviation in Hz (see setup())
+#define BLOCK 8                 //!< samples per vector
+
+typedef float F8 __attribute__((vector_size(4 * BLOCK)));
+typedef int32_t I8 __attribute__((vector_size(4 * BLOCK)));
+typedef uint32_t U8 __attribute__((vector_size(4 * BLOCK)));
+
+//! Sample format
+enum struct Format {
+    CU8,
+    CS16
+};
+
+/*!
+ * \brief sin(2 * pi * phase / 2^32) for 8 phases
+ *
+ * The phase is folded into [-pi/2, pi/2], where the odd Taylor polynomial
+ * of degree 11 is used (max. error ~2e-7 with float arithmetic).
+ * The vectors are passed by reference (no -Wpsabi warning without AVX).
+ */
+static inline void sinPhase(const U8 &phase, F8 &y)
+{
+    I8 p = (I8)phase;
+    const I8 quarter = (I8){} + 0x40000000;
+    // sin(pi - x) = sin(x), sin(-pi - x) = sin(x)
+    p = (p > quarter) ? (I8)((U8){} + 0x80000000U - (U8)p) : p;
+    p = (p < -quarter) ? (I8)((U8){} + 0x80000000U - (U8)p) : p;
+
+    F8 x = __builtin_convertvector(p, F8) * (float)(M_PI / 2147483648.0);
+    F8 x2 = x * x;
+    y = x2 * (-1.0f / 39916800) + (1.0f / 362880);
+    y = y * x2 - (1.0f / 5040);
+    y = y * x2 + (1.0f / 120);
+    y = y * x2 - (1.0f / 6);
+    y = y * x2 + 1.0f;
+    y *= x;
+}
+
+/*!
+ * \brief Streaming continuous phase 2-FSK modulator
+ */
+class FskModulator {
+public:
+    FskModulator(FILE *out, Format format, double sample_rate, double offset, float amplitude)
+        : _out(out), _format(format), _spb(sample_rate / TX_BITRATE), _phase(0), _samples(0)
+    {
+        _fw[0] = freqWord(offset - TX_DEVIATION, sample_rate);
+        _fw[1] = freqWord(offset + TX_DEVIATION, sample_rate);
+        _scale = amplitude * ((format == Format::CU8) ? 127.0f : 32767.0f);
+        _buf.reserve(BUF_SIZE + 4 * BLOCK);
+    }
+
+    ~FskModulator()
+    {
+        flush();
+    }
+
+    //! Samples per bit
+    double spb(void) const
+    {
+        return _spb;
+    }
+
+    //! Number of samples written
+    uint64_t samples(void) const
+    {
+        return _samples;
+    }
+
+    //! Idle (carrier off) until sample n
+    void idleUntil(uint64_t n)
+    {
+        const size_t bytes = sampleSize();
+        while (_samples < n)
+        {
+            uint64_t k = std::min<uint64_t>(n - _samples, (BUF_SIZE - _buf.size()) / bytes + 1);
+            // cu8: 128 (~0), cs16: 0
+            _buf.resize(_buf.size() + k * bytes, (_format == Format::CU8) ? 128 : 0);
+            _samples += k;
+            if (_buf.size() >= BUF_SIZE)
+            {
+                flush();
+            }
+        }
+    }
+
+    //! Modulate frame (MSB first)
+    void frame(const uint8_t *data, size_t len)
+    {
+        uint64_t start = _samples;
+        uint64_t end = start;
+        for (size_t i = 0; i < 8 * len; i++)
+        {
+            int bit = (data[i / 8] >> (7 - i % 8)) & 1;
+            uint64_t next = start + (uint64_t)llround((i + 1) * _spb);
+            run(_fw[bit], next - end);
+            end = next;
+        }
+    }
+
+private:
+    static const size_t BUF_SIZE = 1 << 20;  //!< output buffer size in bytes
+
+    static uint32_t freqWord(double f, double sample_rate)
+    {
+        return (uint32_t)(int32_t)llround(f / sample_rate * 4294967296.0);
+    }
+
+    size_t sampleSize(void) const
+    {
+        return (_format == Format::CU8) ? 2 : 4;
+    }
+
+    //! n samples with frequency word fw
+    void run(uint32_t fw, uint64_t n)
+    {
+        static const U8 iota = {1, 2, 3, 4, 5, 6, 7, 8};
+        const U8 step = iota * fw;
+
+        while (n > 0)
+        {
+            unsigned k = (n < BLOCK) ? n : BLOCK;
+            U8 phase = (U8){} + _phase + step;
+            U8 phase_i = phase + 0x40000000U;
+            F8 q, i;
+            sinPhase(phase, q);
+            sinPhase(phase_i, i);
+            q *= _scale;
+            i *= _scale;
+
+            size_t pos = _buf.size();
+            _buf.resize(pos + k * sampleSize());
+            if (_format == Format::CU8)
+            {
+                I8 iu = __builtin_convertvector(i + 127.5f, I8);
+                I8 qu = __builtin_convertvector(q + 127.5f, I8);
+                uint8_t *p = &_buf[pos];
+                for (unsigned j = 0; j < k; j++)
+                {
+                    p[2 * j] = iu[j];
+                    p[2 * j + 1] = qu[j];
+                }
+            }
+            else
+            {
+                I8 is = __builtin_convertvector(i, I8);
+                I8 qs = __builtin_convertvector(q, I8);
+                int16_t s[2 * BLOCK];
+                for (unsigned j = 0; j < k; j++)
+                {
+                    s[2 * j] = is[j];
+                    s[2 * j + 1] = qs[j];
+                }
+                memcpy(&_buf[pos], s, 4 * k);
+            }
+
+            _phase += k * fw;
+            _samples += k;
+            n -= k;
+            if (_buf.size() >= BUF_SIZE)
+            {
+                flush();
+            }
+        }
+    }
+
+    void flush(void)
+    {
+        if (!_buf.empty() && fwrite(_buf.data(), 1, _buf.size(), _out) != _buf.size())
+        {
+            perror("fwrite");
+            exit(1);
+        }
+        _buf.clear();
+    }
+
+    FILE *_out;
+    Format _format;
+    double _spb;                //!< samples per bit
+    uint32_t _fw[2];            //!< frequency words for bit 0/1
+    float _scale;               //!< full scale
+    uint32_t _phase;            //!< NCO phase
+    uint64_t _samples;          //!< samples written
+    std::vector<uint8_t> _buf;  //!< output buffer
+};
+
+#endif // FSK_MODULATOR_H
@@ -0,0 +1,464 @@
+///////////////////////////////////////////////////////////////////////////////
+// fsk_mod.cpp
+//
+// Host tool - 2-FSK baseband modulator
+//
+// Encoded frames (preamble, sync word and payload as in msg_buf) are
+// modulated as continuous phase 2-FSK (8.21 kbps, deviation 57.136 kHz,
+// as configured in setup()) into complex baseband samples, which are written
+// as .cu8 (8 bit unsigned I/Q, like rtl_sdr) or .cs16 (16 bit signed I/Q)
+// file. The files can be decoded offline by rtl_433, e.g.
+//   rtl_433 -s 250k -r capture.cu8
+//
+// Frame sources:
+// - frame file: one frame per line as hex string, optionally preceded by
+//   the start time in seconds; without time, the frames are separated by
+//   the gap given with -g
+// - synthetic traffic: <n> sensors with the given encoder, transmitting
+//   periodically with equidistant phases for <duration> seconds; the
+//   payloads are encoded by the encoders from PayloadEncoders.h
+//
+// The samples are generated in blocks (streaming, constant memory): the
+// numerically controlled oscillator uses a 32 bit phase accumulator (phase
+// continuous between bits and exact over any duration), the phases of
+// 8 samples are computed at once and converted to I/Q by a polynomial
+// sine approximation on vectors of 8 floats (GCC vector extensions).
+// Between frames, the carrier is off (I/Q = 0).
+//
+// With option -v, the output file is read back, demodulated (FM
+// discriminator) and the bits of each frame are compared with the input.
+//
+// Build (Linux):
+//   g++ -std=c++17 -O3 -march=native -Wall -I../.. -o fsk_mod fsk_mod.cpp
+//   (in extras/fsk_mod)
+//
+// Usage:
+//   fsk_mod [-s <sample_rate>] [-f <offset_hz>] [-a <amplitude>] [-g <gap_ms>] [-v] -o <out.cu8|out.cs16> <frame_file>
+//   fsk_mod [-s <sample_rate>] [-f <offset_hz>] [-a <amplitude>] [-v] -o <out.cu8|out.cs16>
+//           -x <encoder> [-n <sensors>] [-i <interval_s>] -d <duration_s>
+//
+// Examples:
+//   ./fsk_mod -o 6in1_250k.cu8 -x bresser-6in1 -n 4 -d 120
+//   rtl_433 -s 250k -r 6in1_250k.cu8
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          SensorRecord with scaled integers
+//          Moved modulator to FskModulator.h
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "SensorBatch.h"
+#include "FskModulator.h"
+
+#define MAX_FRAME 64            //!< max. frame size in bytes
+
+//! Frame with start time
+struct Frame {
+    uint64_t start;             //!< start sample
+    uint8_t len;                //!< frame size in bytes
+    uint8_t data[MAX_FRAME];    //!< frame
+};
+
+//
+// Frame sources
+//
+
+//! Protocol
+struct Protocol {
+    const char *name;
+    uint8_t size;
+    uint8_t whitening;
+    uint8_t s_type;
+    uint8_t (*encode)(uint8_t *payload, const SensorRecord &rec);
+};
+
+static const Protocol protocols[] = {
+    {"bresser-5in1", 26, 0, SENSOR_TYPE_WEATHER0, encodeBresser5In1<SensorRecord>},
+    {"bresser-6in1", 18, 0, SENSOR_TYPE_WEATHER1, encodeBresser6In1Record},
+    {"bresser-7in1", 26, WHITENING_BRESSER_7IN1, SENSOR_TYPE_WEATHER1, encodeBresser7In1<SensorRecord>},
+    {"bresser-lightning", 10, WHITENING_BRESSER_LIGHTNING, SENSOR_TYPE_LIGHTNING, encodeBresserLightning<SensorRecord>},
+    {"bresser-leakage", 10, 0, SENSOR_TYPE_LEAKAGE, encodeBresserLeakage<SensorRecord>}
+};
+
+//! Read frame file
+static bool loadFrames(const char *filename, double sample_rate, double gap_ms, std::vector<Frame> &frames)
+{
+    FILE *f = fopen(filename, "r");
+    if (!f)
+    {
+        perror(filename);
+        return false;
+    }
+
+    char line[512];
+    double t = 0;
+    while (fgets(line, sizeof(line), f))
+    {
+        char tok1[256];
+        char tok2[256];
+        int n = sscanf(line, "%255s %255s", tok1, tok2);
+        if (n < 1 || tok1[0] == '#')
+        {
+            continue;
+        }
+        const char *hex = (n == 2) ? tok2 : tok1;
+        if (n == 2)
+        {
+            t = atof(tok1);
+        }
+
+        Frame fr = {};
+        fr.start = (uint64_t)llround(t * sample_rate);
+        fr.len = std::min(strlen(hex) / 2, (size_t)MAX_FRAME);
+        for (size_t i = 0; i < fr.len; i++)
+        {
+            unsigned b;
+            sscanf(&hex[2 * i], "%2x", &b);
+            fr.data[i] = b;
+        }
+        frames.push_back(fr);
+        t += 8 * fr.len / TX_BITRATE + gap_ms / 1000;
+    }
+    fclose(f);
+    return true;
+}
+
+//! Generate periodic traffic of n sensors
+static void genFrames(const Protocol &p, unsigned n, double interval, double duration, double sample_rate,
+                      std::vector<Frame> &frames)
+{
+    SensorRecord rec = {};
+    for (uint32_t m = 0; m * interval < duration; m++)
+    {
+        for (unsigned k = 0; k < n; k++)
+        {
+            double t = (m + (double)k / n) * interval;
+            if (t >= duration)
+            {
+                break;
+            }
+            // Slowly changing values
+            rec.sensor_id = 0x1000 + k;
+            rec.s_type = p.s_type;
+            rec.chan = k % 8;
+            rec.startup = (m == 0);
+            rec.battery_ok = true;
+            rec.msg_type = m & 1;
+            rec.w.temp_c10 = 100 + (m + k) % 150;
+            rec.w.humidity = 40 + (m + k) % 50;
+            rec.w.wind_gust_ms10 = (3 * m + k) % 200;
+            rec.w.wind_avg_ms10 = (2 * m + k) % 100;
+            rec.w.wind_dir_deg10 = (m * 7 + k * 45) % 360 * 10;
+            rec.w.rain_mm10 = m;
+            rec.w.uv10 = m % 120;
+            rec.w.light_lux = 500 * (m % 200);
+            rec.lgt.strike_count = m / 10;
+            rec.lgt.distance_km = 1 + (m + k) % 40;
+            rec.leak.alarm = (m % 10) == 0;
+
+            Frame fr = {};
+            fr.start = (uint64_t)llround(t * sample_rate);
+            fr.len = FRAME_HEADER_SIZE + p.size;
+            memcpy(fr.data, frame_header, FRAME_HEADER_SIZE);
+            p.encode(&fr.data[FRAME_HEADER_SIZE], rec);
+            if (p.whitening)
+            {
+                whiten(&fr.data[FRAME_HEADER_SIZE], p.size, p.whitening);
+            }
+            frames.push_back(fr);
+        }
+    }
+}
+
+/*!
+ * \brief Demodulate output file and compare frames
+ *
+ * The sign of the phase difference between successive samples (FM
+ * discriminator) is sampled in the middle of each bit.
+ *
+ * \returns number of bit errors
+ */
+static uint64_t verify(const char *filename, Format format, double spb, const std::vector<Frame> &frames, size_t &frames_ok)
+{
+    FILE *f = fopen(filename, "rb");
+    if (!f)
+    {
+        perror(filename);
+        return UINT64_MAX;
+    }
+
+    const size_t chunk = 1 << 18;
+    const size_t bytes = (format == Format::CU8) ? 2 : 4;
+    std::vector<uint8_t> buf(chunk * bytes);
+    std::vector<float> iq(2 * (chunk + 1));
+    uint64_t base = 0;          // sample index of iq[2]
+    size_t n = 0;               // samples in iq (after the previous sample)
+    uint64_t errors = 0;
+    frames_ok = 0;
+    iq[0] = iq[1] = 0;
+
+    auto load = [&](uint64_t sample) -> bool {
+        while (sample >= base + n)
+        {
+            if (n > 0)
+            {
+                iq[0] = iq[2 * n];
+                iq[1] = iq[2 * n + 1];
+                base += n;
+            }
+            n = fread(buf.data(), bytes, chunk, f);
+            if (n == 0)
+            {
+                return false;
+            }
+            for (size_t j = 0; j < 2 * n; j++)
+            {
+                iq[j + 2] = (format == Format::CU8) ? buf[j] - 127.5f : (float)((int16_t *)buf.data())[j];
+            }
+        }
+        return true;
+    };
+
+    for (const Frame &fr : frames)
+    {
+        unsigned bit_errors = 0;
+        for (size_t i = 0; i < 8U * fr.len; i++)
+        {
+            uint64_t s = fr.start + (uint64_t)((i + 0.5) * spb);
+            if (s == 0 || !load(s))
+            {
+                fclose(f);
+                return UINT64_MAX;
+            }
+            // Previous sample is always in iq (the chunk is large compared to a bit)
+            size_t j = s - base + 1;
+            float cross = iq[2 * (j - 1)] * iq[2 * j + 1] - iq[2 * (j - 1) + 1] * iq[2 * j];
+            int bit = (fr.data[i / 8] >> (7 - i % 8)) & 1;
+            bit_errors += ((cross > 0) != bit);
+        }
+        errors += bit_errors;
+        frames_ok += (bit_errors == 0);
+    }
+    fclose(f);
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    double sample_rate = 250000;
+    double offset = 0;
+    float amplitude = 0.9f;
+    double gap_ms = 100;
+    bool check = false;
+    const char *out_name = nullptr;
+    const char *frame_file = nullptr;
+    const char *encoder = nullptr;
+    unsigned sensors = 1;
+    double interval = 30;
+    double duration = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_arg = (i + 1 < argc);
+        if (strcmp(argv[i], "-s") == 0 && has_arg)
+        {
+            sample_rate = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-f") == 0 && has_arg)
+        {
+            offset = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-a") == 0 && has_arg)
+        {
+            amplitude = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-g") == 0 && has_arg)
+        {
+            gap_ms = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-o") == 0 && has_arg)
+        {
+            out_name = argv[++i];
+        }
+        else if (strcmp(argv[i], "-x") == 0 && has_arg)
+        {
+            encoder = argv[++i];
+        }
+        else if (strcmp(argv[i], "-n") == 0 && has_arg)
+        {
+            sensors = std::max(1, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "-i") == 0 && has_arg)
+        {
+            interval = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-d") == 0 && has_arg)
+        {
+            duration = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-v") == 0)
+        {
+            check = true;
+        }
+        else if (argv[i][0] != '-')
+        {
+            frame_file = argv[i];
+        }
+        else
+        {
+            out_name = nullptr;
+            break;
+        }
+    }
+
+    if (!out_name || (!frame_file && !(encoder && duration > 0)) || sample_rate < 4 * TX_DEVIATION || amplitude <= 0 || amplitude > 1)
+    {
+        fprintf(stderr, "Usage: %s [-s <sample_rate>] [-f <offset_hz>] [-a <amplitude>] [-g <gap_ms>] [-v] -o <out.cu8|out.cs16> <frame_file>\n"
+                        "       %s [-s <sample_rate>] [-f <offset_hz>] [-a <amplitude>] [-v] -o <out.cu8|out.cs16>\n"
+                        "          -x <encoder> [-n <sensors>] [-i <interval_s>] -d <duration_s>\n", argv[0], argv[0]);
+        return 1;
+    }
+
+    size_t name_len = strlen(out_name);
+    Format format;
+    if (name_len > 4 && strcmp(&out_name[name_len - 4], ".cu8") == 0)
+    {
+        format = Format::CU8;
+    }
+    else if (name_len > 5 && strcmp(&out_name[name_len - 5], ".cs16") == 0)
+    {
+        format = Format::CS16;
+    }
+    else
+    {
+        fprintf(stderr, "Output file extension must be .cu8 or .cs16!\n");
+        return 1;
+    }
+
+    std::vector<Frame> frames;
+    if (frame_file)
+    {
+        if (!loadFrames(frame_file, sample_rate, gap_ms, frames))
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        const Protocol *p = nullptr;
+        for (const Protocol &proto : protocols)
+        {
+            if (strcmp(encoder, proto.name) == 0)
+            {
+                p = &proto;
+            }
+        }
+        if (!p)
+        {
+            fprintf(stderr, "Unknown encoder '%s'!\n", encoder);
+            return 1;
+        }
+        genFrames(*p, sensors, interval, duration, sample_rate, frames);
+    }
+
+    FILE *out = fopen(out_name, "wb");
+    if (!out)
+    {
+        perror(out_name);
+        return 1;
+    }
+
+    size_t delayed = 0;
+    uint64_t samples;
+    uint64_t mod_samples = 0;
+    std::chrono::duration<double> t_mod(0);
+    auto t0 = std::chrono::steady_clock::now();
+    {
+        FskModulator mod(out, format, sample_rate, offset, amplitude);
+        for (Frame &fr : frames)
+        {
+            // Overlapping frames are delayed (the modulator renders one frame at a time)
+            if (fr.start < mod.samples())
+            {
+                fr.start = mod.samples();
+                delayed++;
+            }
+            mod.idleUntil(fr.start);
+            auto t1 = std::chrono::steady_clock::now();
+            mod.frame(fr.data, fr.len);
+            t_mod += std::chrono::steady_clock::now() - t1;
+            mod_samples += mod.samples() - fr.start;
+        }
+        // Idle until end of duration or one frame time after the last frame
+        mod.idleUntil(std::max((uint64_t)llround(duration * sample_rate), mod.samples() + (uint64_t)(8 * MAX_FRAME * mod.spb())));
+        samples = mod.samples();
+    }
+    fclose(out);
+    std::chrono::duration<double> t = std::chrono::steady_clock::now() - t0;
+
+    printf("Frames: %zu (%zu delayed due to overlap), samples: %llu (%.1f s at %.0f S/s)\n",
+           frames.size(), delayed, (unsigned long long)samples, samples / sample_rate, sample_rate);
+    printf("Total:      %.2f s, %.3g samples/s (%.0fx real time)\n",
+           t.count(), samples / t.count(), samples / sample_rate / t.count());
+    if (t_mod.count() > 0)
+    {
+        printf("Modulation: %.3g samples/s (frames only)\n", mod_samples / t_mod.count());
+    }
+
+    if (check)
+    {
+        size_t frames_ok;
+        uint64_t errors = verify(out_name, format, sample_rate / TX_BITRATE, frames, frames_ok);
+        if (errors == UINT64_MAX)
+        {
+            fprintf(stderr, "Verification failed - output file too short!\n");
+            return 1;
+        }
+        printf("Verification: %zu/%zu frames without bit errors, %llu bit errors\n",
+               frames_ok, frames.size(), (unsigned long long)errors);
+        return (errors > 0) ? 1 : 0;
+    }
+    return 0;
+}
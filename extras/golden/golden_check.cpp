@@ -0,0 +1,614 @@
+///////////////////////////////////////////////////////////////////////////////
+// golden_check.cpp
+//
+// Host regression and benchmark tool - golden vectors (captured payloads)
+//
+// Each payload from the corpus (vectors.txt) is
+// - decoded (like rtl_433/BresserWeatherSensorReceiver; the digest/checksum
+//   is verified where the algorithm is known),
+// - re-encoded from the decoded values by the respective encoder from
+//   PayloadEncoders.h and
+// - compared with the captured payload:
+//   EXACT  - all payload bytes identical
+//   FIELDS - all decoded fields identical; other bits (unknown fields,
+//            trailer) and the digest/checksum computed over them differ
+//   FAIL   - decoded fields differ
+//   SKIP   - digest/checksum of capture fails (corrupted capture) - not
+//            compared and not used as benchmark input
+//
+// With option -b, the decoded corpus is used as fixed input set for
+// measuring the throughput of each encoder (payload encoding and whitening,
+// as in transmitFrame()).
+//
+// Build (Linux):
+//   g++ -std=c++17 -O2 -Wall -I../.. -o golden_check golden_check.cpp
+//   (in extras/golden)
+//
+// Usage:
+//   golden_check [-b [<rounds>]] [<vectors_file>]
+//
+// The exit code is 1 if any vector fails.
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          SensorRecord with scaled integers
+//          6-in-1 soil moisture: Fixed index decoding (1...16, BCD)
+//          Captures with digest/checksum failure are skipped
+//          Leakage: CRC-16 digest checked (see digest_search)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "SensorBatch.h"
+
+#define MAX_PAYLOAD 26          //!< max. payload size
+
+//! Digest/checksum state of captured payload
+enum CheckState {
+    CHECK_UNKNOWN,              //!< algorithm not known
+    CHECK_OK,
+    CHECK_FAIL,
+    CHECK_SHORT                 //!< capture too short
+};
+
+static const char *check_names[] = {"-", "ok", "FAIL", "short"};
+
+//! Decoded payload
+struct Decoded {
+    SensorRecord rec;           //!< sensor data
+    CheckState check;           //!< digest/checksum state
+    uint8_t known[MAX_PAYLOAD]; //!< payload bits represented in rec
+};
+
+//! Golden vector
+struct Vector {
+    int line;                   //!< line number in corpus file
+    std::string encoder;        //!< encoder name
+    std::vector<uint8_t> data;  //!< captured payload
+    size_t nibbles;             //!< length of captured payload in nibbles
+    std::string comment;        //!< comment
+    Decoded dec;                //!< decoded payload
+};
+
+//
+// Bit field access - bit position 0 is the MSB of byte 0 (as in PayloadLayout.h)
+//
+
+//! Unsigned field
+static uint32_t bits(const uint8_t *msg, uint16_t pos, uint8_t n)
+{
+    uint32_t v = 0;
+    for (uint16_t i = pos; i < pos + n; i++)
+    {
+        v = (v << 1) | ((msg[i / 8] >> (7 - i % 8)) & 1);
+    }
+    return v;
+}
+
+//! BCD field is valid (all digits <= 9)
+static bool bcdValid(const uint8_t *msg, uint16_t pos, uint8_t digits, bool inverted = false)
+{
+    for (uint8_t d = 0; d < digits; d++)
+    {
+        uint8_t nibble = bits(msg, pos + 4 * d, 4) ^ (inverted ? 0xF : 0);
+        if (nibble > 9)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! BCD field value
+static uint32_t bcd(const uint8_t *msg, uint16_t pos, uint8_t digits, bool inverted = false)
+{
+    uint32_t v = 0;
+    for (uint8_t d = 0; d < digits; d++)
+    {
+        v = v * 10 + (bits(msg, pos + 4 * d, 4) ^ (inverted ? 0xF : 0));
+    }
+    return v;
+}
+
+//! Mark field as decoded
+static void mark(uint8_t *known, uint16_t pos, uint8_t n)
+{
+    for (uint16_t i = pos; i < pos + n; i++)
+    {
+        known[i / 8] |= 0x80 >> (i % 8);
+    }
+}
+
+//
+// Decoders - see comments in PayloadEncoders.h
+//
+
+static const uint8_t moisture_map[16] = {0, 7, 13, 20, 27, 33, 40, 47, 53, 60, 67, 73, 80, 87, 93, 99};
+
+static void decode5In1(const uint8_t *msg, Decoded &d)
+{
+    SensorRecord &r = d.rec;
+
+    d.check = CHECK_OK;
+    for (int i = 0; i < 13; i++)
+    {
+        if ((msg[i] ^ msg[i + 13]) != 0xFF)
+        {
+            d.check = CHECK_FAIL;
+        }
+    }
+    if (bitCount(&msg[14], 12) != msg[13])
+    {
+        d.check = CHECK_FAIL;
+    }
+
+    r.sensor_id = msg[14];
+    mark(d.known, 8 * 14, 8);
+    r.startup = !bits(msg, 8 * 15, 1);
+    mark(d.known, 8 * 15, 1);
+    r.s_type = bits(msg, 8 * 15 + 4, 4);
+    mark(d.known, 8 * 15 + 4, 4);
+    r.w.wind_gust_ms10 = bits(msg, 8 * 17 + 4, 4) << 8 | msg[16];
+    mark(d.known, 8 * 16, 8);
+    mark(d.known, 8 * 17 + 4, 4);
+    r.w.wind_dir_deg10 = bits(msg, 8 * 17, 4) * 225;
+    mark(d.known, 8 * 17, 4);
+    if (bcdValid(msg, 8 * 18, 2) && bcdValid(msg, 8 * 19 + 4, 1))
+    {
+        r.w.wind_avg_ms10 = bcd(msg, 8 * 19 + 4, 1) * 100 + bcd(msg, 8 * 18, 2);
+        mark(d.known, 8 * 18, 8);
+        mark(d.known, 8 * 19 + 4, 4);
+    }
+    if (bcdValid(msg, 8 * 20, 2) && bcdValid(msg, 8 * 21 + 4, 1) && bits(msg, 8 * 25 + 4, 4) <= 1)
+    {
+        r.w.temp_c10 = bcd(msg, 8 * 21 + 4, 1) * 100 + bcd(msg, 8 * 20, 2);
+        if (bits(msg, 8 * 25 + 4, 4))
+        {
+            r.w.temp_c10 = -r.w.temp_c10;
+        }
+        mark(d.known, 8 * 20, 8);
+        mark(d.known, 8 * 21 + 4, 4);
+        mark(d.known, 8 * 25 + 4, 4);
+    }
+    if (bcdValid(msg, 8 * 22, 2))
+    {
+        r.w.humidity = bcd(msg, 8 * 22, 2);
+        mark(d.known, 8 * 22, 8);
+    }
+    if (bcdValid(msg, 8 * 23, 4))
+    {
+        r.w.rain_mm10 = bcd(msg, 8 * 24, 2) * 100 + bcd(msg, 8 * 23, 2);
+        mark(d.known, 8 * 23, 16);
+    }
+    r.battery_ok = !bits(msg, 8 * 25, 1);
+    mark(d.known, 8 * 25, 1);
+}
+
+static void decode6In1(const uint8_t *msg, Decoded &d)
+{
+    SensorRecord &r = d.rec;
+
+    int digest = lfsr_digest16(&msg[2], 15, 0x8810, 0x5412);
+    d.check = (digest == (msg[0] << 8 | msg[1]) && (add_bytes(&msg[2], 16) & 0xFF) == 0xFF) ? CHECK_OK : CHECK_FAIL;
+
+    r.sensor_id = bits(msg, 8 * 2, 32);
+    r.s_type = bits(msg, 8 * 6, 4);
+    r.startup = !bits(msg, 8 * 6 + 4, 1);
+    r.chan = bits(msg, 8 * 6 + 5, 3);
+    mark(d.known, 8 * 2, 40);
+
+    if (bcdValid(msg, 8 * 7, 3, true))
+    {
+        r.w.wind_gust_ms10 = bcd(msg, 8 * 7, 3, true);
+        mark(d.known, 8 * 7, 12);
+    }
+    if (bcdValid(msg, 8 * 9, 2, true) && bcdValid(msg, 8 * 8 + 4, 1, true))
+    {
+        r.w.wind_avg_ms10 = bcd(msg, 8 * 9, 2, true) * 10 + bcd(msg, 8 * 8 + 4, 1, true);
+        mark(d.known, 8 * 8 + 4, 12);
+    }
+    if (bcdValid(msg, 8 * 10, 3))
+    {
+        r.w.wind_dir_deg10 = bcd(msg, 8 * 10, 3) * 10;
+        mark(d.known, 8 * 10, 12);
+    }
+    if (bcdValid(msg, 8 * 15, 3, true))
+    {
+        r.w.uv10 = bcd(msg, 8 * 15, 3, true);
+        mark(d.known, 8 * 15, 12);
+    }
+
+    r.msg_type = bits(msg, 8 * 16 + 7, 1) ? BRESSER_6IN1_MSG_RAIN : BRESSER_6IN1_MSG_TEMP;
+    mark(d.known, 8 * 16 + 7, 1);
+
+    if (r.msg_type == BRESSER_6IN1_MSG_RAIN)
+    {
+        if (bcdValid(msg, 8 * 12, 6, true))
+        {
+            r.w.rain_mm10 = bcd(msg, 8 * 12, 6, true);
+            mark(d.known, 8 * 12, 24);
+        }
+        return;
+    }
+
+    r.battery_ok = bits(msg, 8 * 13 + 6, 1);
+    mark(d.known, 8 * 13 + 6, 1);
+    if (bcdValid(msg, 8 * 12, 3))
+    {
+        int temp_c10 = bcd(msg, 8 * 12, 3);
+        if (bits(msg, 8 * 13 + 4, 1))
+        {
+            temp_c10 -= 1000;
+        }
+        r.w.temp_c10 = temp_c10;
+        r.soil.temp_c10 = temp_c10;
+        mark(d.known, 8 * 12, 13);
+    }
+    if (r.s_type == SENSOR_TYPE_SOIL)
+    {
+        // Moisture index 1...16 (BCD)
+        if (bcdValid(msg, 8 * 14, 2))
+        {
+            int idx = bcd(msg, 8 * 14, 2);
+            if (idx >= 1 && idx <= 16)
+            {
+                r.soil.moisture = moisture_map[idx - 1];
+                mark(d.known, 8 * 14, 8);
+            }
+        }
+    }
+    else if (r.s_type != SENSOR_TYPE_POOL_THERMO)
+    {
+        if (bcdValid(msg, 8 * 14, 2))
+        {
+            r.w.humidity = bcd(msg, 8 * 14, 2);
+            mark(d.known, 8 * 14, 8);
+        }
+    }
+}
+
+static void decode7In1(const uint8_t *raw, Decoded &d)
+{
+    SensorRecord &r = d.rec;
+    uint8_t msg[MAX_PAYLOAD];
+
+    for (int i = 0; i < MAX_PAYLOAD; i++)
+    {
+        msg[i] = raw[i] ^ WHITENING_BRESSER_7IN1;
+    }
+    int digest = lfsr_digest16(&msg[2], 23, 0x8810, 0xba95) ^ 0x6df1;
+    d.check = (digest == (msg[0] << 8 | msg[1])) ? CHECK_OK : CHECK_FAIL;
+
+    r.sensor_id = bits(msg, 8 * 2, 16);
+    mark(d.known, 8 * 2, 16);
+    // STYPE, STARTUP and CH are not covered by whitening
+    r.s_type = bits(raw, 8 * 6, 4);
+    r.startup = !bits(raw, 8 * 6 + 4, 1);
+    r.chan = bits(raw, 8 * 6 + 5, 3);
+    mark(d.known, 8 * 6, 8);
+
+    uint8_t flags = bits(msg, 8 * 15 + 4, 4);
+    if (flags == 0 || flags == 6)
+    {
+        r.battery_ok = (flags == 0);
+        mark(d.known, 8 * 15 + 4, 4);
+    }
+
+    if (r.s_type != SENSOR_TYPE_WEATHER1)
+    {
+        return;
+    }
+    if (bcdValid(msg, 8 * 4, 3))
+    {
+        r.w.wind_dir_deg10 = bcd(msg, 8 * 4, 3) * 10;
+        mark(d.known, 8 * 4, 12);
+    }
+    if (bcdValid(msg, 8 * 7, 3))
+    {
+        r.w.wind_gust_ms10 = bcd(msg, 8 * 7, 3);
+        mark(d.known, 8 * 7, 12);
+    }
+    if (bcdValid(msg, 8 * 8 + 4, 3))
+    {
+        r.w.wind_avg_ms10 = bcd(msg, 8 * 8 + 4, 3);
+        mark(d.known, 8 * 8 + 4, 12);
+    }
+    if (bcdValid(msg, 8 * 10, 6))
+    {
+        r.w.rain_mm10 = bcd(msg, 8 * 10, 6);
+        mark(d.known, 8 * 10, 24);
+    }
+    if (bcdValid(msg, 8 * 14, 3))
+    {
+        int temp_raw = bcd(msg, 8 * 14, 3);
+        r.w.temp_c10 = (temp_raw > 600) ? temp_raw - 1000 : temp_raw;
+        mark(d.known, 8 * 14, 12);
+    }
+    if (bcdValid(msg, 8 * 16, 2))
+    {
+        r.w.humidity = bcd(msg, 8 * 16, 2);
+        mark(d.known, 8 * 16, 8);
+    }
+    if (bcdValid(msg, 8 * 17, 6))
+    {
+        r.w.light_lux = bcd(msg, 8 * 17, 6);
+        mark(d.known, 8 * 17, 24);
+    }
+    if (bcdValid(msg, 8 * 20, 3))
+    {
+        r.w.uv10 = bcd(msg, 8 * 20, 3);
+        mark(d.known, 8 * 20, 12);
+    }
+}
+
+static void decodeLeakage(const uint8_t *msg, Decoded &d)
+{
+    SensorRecord &r = d.rec;
+
+    // CRC-16 (polynomial 0x1021, init 0x0000) over bytes 2...6
+    uint16_t crc = crc16(&msg[2], 5, 0x1021, 0x0000);
+    d.check = (crc == (msg[0] << 8 | msg[1])) ? CHECK_OK : CHECK_FAIL;
+
+    r.sensor_id = bits(msg, 8 * 2, 32);
+    r.s_type = bits(msg, 8 * 6, 4);
+    r.startup = !bits(msg, 8 * 6 + 4, 1);
+    r.chan = bits(msg, 8 * 6 + 5, 3);
+    mark(d.known, 8 * 2, 40);
+
+    bool alarm = bits(msg, 8 * 7, 1);
+    bool nalarm = bits(msg, 8 * 7 + 1, 1);
+    uint8_t batt = bits(msg, 8 * 7 + 2, 2);
+    if (alarm != nalarm && (batt == 0 || batt == 3))
+    {
+        r.leak.alarm = alarm;
+        r.battery_ok = (batt == 3);
+        mark(d.known, 8 * 7, 4);
+    }
+}
+
+//! Protocol
+struct Protocol {
+    const char *name;
+    uint8_t size;
+    uint8_t whitening;
+    void (*decode)(const uint8_t *msg, Decoded &d);
+    uint8_t (*encode)(uint8_t *payload, const SensorRecord &rec);
+};
+
+static const Protocol protocols[] = {
+    {"bresser-5in1", 26, 0, decode5In1, encodeBresser5In1<SensorRecord>},
+    {"bresser-6in1", 18, 0, decode6In1, encodeBresser6In1Record},
+    {"bresser-7in1", 26, WHITENING_BRESSER_7IN1, decode7In1, encodeBresser7In1<SensorRecord>},
+    {"bresser-lightning", 10, WHITENING_BRESSER_LIGHTNING, nullptr, encodeBresserLightning<SensorRecord>},
+    {"bresser-leakage", 10, 0, decodeLeakage, encodeBresserLeakage<SensorRecord>}
+};
+
+static const Protocol *findProtocol(const std::string &name)
+{
+    for (const Protocol &p : protocols)
+    {
+        if (name == p.name)
+        {
+            return &p;
+        }
+    }
+    return nullptr;
+}
+
+//! Encode payload and apply whitening
+static inline void encode(const Protocol &p, uint8_t *payload, const SensorRecord &rec)
+{
+    memset(payload, 0, p.size);
+    p.encode(payload, rec);
+    if (p.whitening)
+    {
+        whiten(payload, p.size, p.whitening);
+    }
+}
+
+//! Load corpus
+static bool load(const char *filename, std::vector<Vector> &vectors)
+{
+    FILE *f = fopen(filename, "r");
+    if (!f)
+    {
+        perror(filename);
+        return false;
+    }
+
+    char line[512];
+    int n = 0;
+    while (fgets(line, sizeof(line), f))
+    {
+        n++;
+        char name[32];
+        char hex[256];
+        int pos = 0;
+        if (line[0] == '#' || sscanf(line, "%31s %255s %n", name, hex, &pos) < 2)
+        {
+            continue;
+        }
+
+        Vector v;
+        v.line = n;
+        v.encoder = name;
+        v.nibbles = strlen(hex);
+        v.data.assign(MAX_PAYLOAD + (v.nibbles + 1) / 2, 0);
+        for (size_t i = 0; i < v.nibbles; i++)
+        {
+            char c = hex[i];
+            uint8_t nibble = (c >= '0' && c <= '9') ? c - '0' : (c | 0x20) - 'a' + 10;
+            v.data[i / 2] |= nibble << ((i % 2) ? 0 : 4);
+        }
+        v.comment = line + pos;
+        while (!v.comment.empty() && (v.comment.back() == '\n' || v.comment.back() == '\r'))
+        {
+            v.comment.pop_back();
+        }
+        vectors.push_back(v);
+    }
+    fclose(f);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *filename = "vectors.txt";
+    bool bench = false;
+    size_t rounds = 100000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-b") == 0)
+        {
+            bench = true;
+            if (i + 1 < argc && atol(argv[i + 1]) > 0)
+            {
+                rounds = atol(argv[++i]);
+            }
+        }
+        else
+        {
+            filename = argv[i];
+        }
+    }
+
+    std::vector<Vector> vectors;
+    if (!load(filename, vectors))
+    {
+        return 1;
+    }
+
+    int count[4] = {0, 0, 0, 0};
+    printf("%5s %-18s %-6s %-7s %s\n", "Line", "Encoder", "Check", "Result", "Comment");
+    for (Vector &v : vectors)
+    {
+        const Protocol *p = findProtocol(v.encoder);
+        if (!p || !p->decode)
+        {
+            fprintf(stderr, "%s:%d: no decoder for '%s'\n", filename, v.line, v.encoder.c_str());
+            return 1;
+        }
+
+        memset(&v.dec, 0, sizeof(v.dec));
+        p->decode(v.data.data(), v.dec);
+        if (v.nibbles < 2U * p->size)
+        {
+            v.dec.check = CHECK_SHORT;
+        }
+
+        if (v.dec.check == CHECK_FAIL)
+        {
+            count[3]++;
+            printf("%5d %-18s %-6s %-7s %s\n", v.line, p->name, check_names[v.dec.check], "SKIP", v.comment.c_str());
+            continue;
+        }
+
+        uint8_t payload[MAX_PAYLOAD];
+        encode(*p, payload, v.dec.rec);
+
+        // Compare complete bytes of capture only
+        size_t n = (v.nibbles / 2 < p->size) ? v.nibbles / 2 : p->size;
+        bool exact = (n == p->size);
+        bool fields = true;
+        char diff[2 * MAX_PAYLOAD + 1] = "";
+        for (size_t i = 0; i < n; i++)
+        {
+            uint8_t d = payload[i] ^ v.data[i];
+            exact &= (d == 0);
+            fields &= ((d & v.dec.known[i]) == 0);
+            snprintf(&diff[2 * i], 3, "%02x", d & v.dec.known[i]);
+        }
+
+        int result = exact ? 0 : fields ? 1 : 2;
+        static const char *results[] = {"EXACT", "FIELDS", "FAIL"};
+        count[result]++;
+        printf("%5d %-18s %-6s %-7s %s\n", v.line, p->name, check_names[v.dec.check], results[result], v.comment.c_str());
+        if (result == 2)
+        {
+            printf("      field bits differing: %s\n", diff);
+        }
+    }
+    printf("\n%zu vectors: %d exact, %d fields, %d failed, %d skipped\n", vectors.size(), count[0], count[1], count[2], count[3]);
+
+    if (bench)
+    {
+        // Throughput with decoded corpus as input
+        printf("\n%-18s %8s %12s %12s\n", "Encoder", "Vectors", "[ns/frame]", "[frames/s]");
+        uint32_t sink = 0;
+        for (const Protocol &p : protocols)
+        {
+            std::vector<SensorRecord> records;
+            for (const Vector &v : vectors)
+            {
+                if (v.encoder == p.name && v.dec.check != CHECK_FAIL)
+                {
+                    records.push_back(v.dec.rec);
+                }
+            }
+            if (records.empty())
+            {
+                continue;
+            }
+
+            uint8_t payload[MAX_PAYLOAD];
+            auto t0 = std::chrono::steady_clock::now();
+            for (size_t r = 0; r < rounds; r++)
+            {
+                for (const SensorRecord &rec : records)
+                {
+                    encode(p, payload, rec);
+                    sink += payload[0];
+                }
+            }
+            std::chrono::duration<double> t = std::chrono::steady_clock::now() - t0;
+            double ns = t.count() * 1e9 / (rounds * records.size());
+            printf("%-18s %8zu %12.1f %12.0f\n", p.name, records.size(), ns, 1e9 / ns);
+        }
+        if (sink == 0xFFFFFFFF)
+        {
+            printf("\n");
+        }
+    }
+
+    return (count[2] > 0) ? 1 : 0;
+}
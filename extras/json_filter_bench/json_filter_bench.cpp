@@ -0,0 +1,494 @@
+///////////////////////////////////////////////////////////////////////////////
+// json_filter_bench.cpp
+//
+// Host benchmark - JSON deserialization with filter (JsonFilter.h) vs.
+// without filter
+//
+// Receiver output lines contain the sensor data keys consumed by
+// deSerialize() and a number of keys which are not used by SensorTransmitter
+// (time, model, modulation, frequencies, signal level etc.). For each
+// encoder/sensor type, the lines are deserialized
+// - unfiltered: all keys are stored in the JSON document
+// - filtered:   sensor type pre-scan (jsonSType()), filter selection and
+//               deserialization with the filter for the encoder/sensor type
+// and the consumed keys are read from the document. The results of both
+// paths are compared before the measurement.
+//
+// Reported per line:
+// - parse time in ns (deserialization and reading of the consumed keys)
+// - peak heap usage during deserialization and heap usage of the document
+//   after shrinkToFit() in bytes (counted by a custom allocator; note that
+//   the host uses 64 bit pointers - the sizes on 32 bit MCUs are smaller,
+//   the ratio is similar)
+//
+// Without input file, synthetic lines in the format of the receiver output
+// are used. With input file (one JSON object per line, e.g. captured
+// receiver output), all lines are parsed with the encoder given by -x.
+//
+// Build (Linux):
+//   g++ -std=c++17 -O2 -Wall -I../.. -I<ArduinoJson>/src -o json_filter_bench json_filter_bench.cpp
+//   (in extras/json_filter_bench; ArduinoJson 7 from https://github.com/bblanchon/ArduinoJson)
+//
+// Usage:
+//   json_filter_bench [-n <lines>]
+//   json_filter_bench -x <encoder> <json_file>
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Check ArduinoJson version and filtered deserialization errors
+//          PRNG and time measurement from ../common/BenchHarness.h
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+#include <ArduinoJson.h>
+#include "JsonFilter.h"
+#include "../common/BenchHarness.h"
+
+#if !defined(ARDUINOJSON_VERSION_MAJOR) || ARDUINOJSON_VERSION_MAJOR < 7
+#error "ArduinoJson 7 is required (Allocator interface, elastic JsonDocument)"
+#endif
+
+#define DEFAULT_LINES   1000    //!< synthetic lines per case
+#define MIN_TIME        0.2     //!< min. measurement time per path in s
+
+//! Encoder names - index: Encoders (see SensorTransmitter.h)
+static const char *const encoder_names[] = {
+    "bresser-5in1", "bresser-6in1", "bresser-7in1", "bresser-leakage", "bresser-lightning"
+};
+
+//! Test case
+struct Case {
+    const char *name;
+    uint8_t encoder;    //!< index: Encoders
+    int s_type;         //!< sensor type in synthetic lines
+    const char *model;  //!< receiver model name
+};
+
+static const Case cases[] = {
+    {"5in1 weather", 0, SENSOR_TYPE_WEATHER0, "Bresser-5in1"},
+    {"6in1 weather", 1, SENSOR_TYPE_WEATHER1, "Bresser-6in1"},
+    {"6in1 soil", 1, SENSOR_TYPE_SOIL, "Bresser-6in1"},
+    {"7in1 weather", 2, SENSOR_TYPE_WEATHER1, "Bresser-7in1"},
+    {"7in1 air pm", 2, SENSOR_TYPE_AIR_PM, "Bresser-7in1"},
+    {"7in1 co2", 2, SENSOR_TYPE_CO2, "Bresser-7in1"},
+    {"7in1 hcho/voc", 2, SENSOR_TYPE_HCHO_VOC, "Bresser-7in1"},
+    {"leakage", 3, SENSOR_TYPE_LEAKAGE, "Bresser-Leakage"},
+    {"lightning", 4, SENSOR_TYPE_LIGHTNING, "Bresser-Lightning"}
+};
+
+/*!
+ * \brief Allocator which counts the heap usage
+ *
+ * Each block is preceded by its size.
+ */
+class CountingAllocator : public ArduinoJson::Allocator {
+public:
+    size_t current = 0; //!< bytes allocated
+    size_t peak = 0;    //!< max. bytes allocated since resetPeak()
+
+    void resetPeak(void)
+    {
+        peak = current;
+    }
+
+    void *allocate(size_t size) override
+    {
+        size_t *p = static_cast<size_t *>(malloc(HDR + size));
+        if (!p)
+        {
+            return nullptr;
+        }
+        *p = size;
+        add(size);
+        return reinterpret_cast<uint8_t *>(p) + HDR;
+    }
+
+    void deallocate(void *ptr) override
+    {
+        if (!ptr)
+        {
+            return;
+        }
+        size_t *p = reinterpret_cast<size_t *>(static_cast<uint8_t *>(ptr) - HDR);
+        current -= *p;
+        free(p);
+    }
+
+    void *reallocate(void *ptr, size_t new_size) override
+    {
+        if (!ptr)
+        {
+            return allocate(new_size);
+        }
+        size_t *p = reinterpret_cast<size_t *>(static_cast<uint8_t *>(ptr) - HDR);
+        size_t old_size = *p;
+        p = static_cast<size_t *>(realloc(p, HDR + new_size));
+        if (!p)
+        {
+            return nullptr;
+        }
+        *p = new_size;
+        current -= old_size;
+        add(new_size);
+        return reinterpret_cast<uint8_t *>(p) + HDR;
+    }
+
+private:
+    static const size_t HDR = alignof(max_align_t);
+
+    void add(size_t size)
+    {
+        current += size;
+        if (current > peak)
+        {
+            peak = current;
+        }
+    }
+};
+
+static XorShift32 rng;
+
+//! Generate line in the format of the receiver output
+static std::string genLine(const Case &c, uint32_t seq)
+{
+    char buf[512];
+    int n = snprintf(buf, sizeof(buf),
+                     "{\"time\":\"2026-10-16 %02u:%02u:%02u\",\"model\":\"%s\",\"sensor_id\":%u,\"s_type\":%d,"
+                     "\"chan\":%u,\"startup\":%d,\"battery_ok\":%d",
+                     (seq / 3600) % 24, (seq / 60) % 60, seq % 60, c.model,
+                     0x10000000u + (rng.state & 0xFFFFFFu), c.s_type, (unsigned)rng.uniform(0, 7.99f),
+                     rng.uniform(0, 1) < 0.1f, rng.uniform(0, 1) < 0.9f);
+
+    uint32_t keys = jsonKeys(c.encoder, c.s_type);
+    float gust = rng.uniform(0, 30);
+    if (keys & JK(JK_TEMP_C))
+        n += snprintf(&buf[n], sizeof(buf) - n, ",\"temp_c\":%.1f", rng.uniform(-20, 40));
+    if (keys & JK(JK_HUMIDITY))
+        n += snprintf(&buf[n], sizeof(buf) - n, ",\"humidity\":%d", (int)rng.uniform(10, 99));
+    if (keys & JK(JK_WIND_GUST))
+        n += snprintf(&buf[n], sizeof(buf) - n, ",\"wind_max_m_s\":%.1f,\"wind_gust_meter_sec\":%.1f,"
+                      "\"wind_avg_meter_sec\":%.1f,\"wind_direction_deg\":%.0f",
+                      gust, gust, gust * 0.6f, rng.uniform(0, 359));
+    if (keys & JK(JK_RAIN))
+        n += snprintf(&buf[n], sizeof(buf) - n, ",\"rain_mm\":%.1f", rng.uniform(0, 9999));
+    if (keys & JK(JK_UV))
+        n += snprintf(&buf[n], sizeof(buf) - n, ",\"uv\":%.1f", rng.uniform(0, 12));
+    if (keys & JK(JK_LIGHT))
+        n += snprintf(&buf[n], sizeof(buf) - n, ",\"light_klx\":%.3f,\"light_lux\":%.0f",
+                      rng.uniform(0, 150), rng.uniform(0, 150000));
+    if (keys & JK(JK_MOISTURE))
+        n += snprintf(&buf[n], sizeof(buf) - n, ",\"moisture\":%d", (int)rng.uniform(0, 99));
+    if (keys & JK(JK_PM_2_5))
+        n += snprintf(&buf[n], sizeof(buf) - n, ",\"pm_1_0\":%d,\"pm_2_5\":%d,\"pm_10\":%d",
+                      (int)rng.uniform(0, 300), (int)rng.uniform(0, 500), (int)rng.uniform(0, 999));
+    if (keys & JK(JK_CO2))
+        n += snprintf(&buf[n], sizeof(buf) - n, ",\"co2_ppm\":%d", (int)rng.uniform(400, 5000));
+    if (keys & JK(JK_HCHO))
+        n += snprintf(&buf[n], sizeof(buf) - n, ",\"hcho_ppb\":%d,\"voc\":%d",
+                      (int)rng.uniform(0, 999), (int)rng.uniform(1, 5));
+    if (keys & JK(JK_STRIKE_COUNT))
+        n += snprintf(&buf[n], sizeof(buf) - n, ",\"strike_count\":%d,\"distance_km\":%d",
+                      (int)rng.uniform(0, 1599), (int)rng.uniform(0, 40));
+    if (keys & JK(JK_ALARM))
+        n += snprintf(&buf[n], sizeof(buf) - n, ",\"alarm\":%d", rng.uniform(0, 1) < 0.5f);
+
+    snprintf(&buf[n], sizeof(buf) - n,
+             ",\"mic\":\"CRC\",\"mod\":\"FSK\",\"freq1\":%.3f,\"freq2\":%.3f,\"rssi\":%.3f,\"snr\":%.3f,\"noise\":%.3f}",
+             868.3f + rng.uniform(-0.05f, 0.05f), 868.2f + rng.uniform(-0.05f, 0.05f),
+             rng.uniform(-20, -1), rng.uniform(5, 30), rng.uniform(-35, -25));
+    return buf;
+}
+
+//! Read consumed keys from document - see deSerialize()
+static float readKeys(const JsonDocument &doc, uint32_t keys, float *values)
+{
+    float sum = 0;
+    for (uint8_t i = 0; i < JK_NUM; i++)
+    {
+        float v = (keys & JK(i)) ? doc[json_keys[i]].as<float>() : 0;
+        if (values)
+        {
+            values[i] = v;
+        }
+        sum += v;
+    }
+    return sum;
+}
+
+//! Parser state of the filtered path - see deSerialize()
+struct FilteredParser {
+    JsonDocument filter;
+    uint32_t filter_keys = 0;
+    uint8_t encoder;
+
+    DeserializationError parse(JsonDocument &doc, const char *line, uint32_t &keys)
+    {
+        int s_type = jsonSType(line);
+        DeserializationError error;
+        for (;;)
+        {
+            keys = jsonKeys(encoder, s_type);
+            if (keys != filter_keys)
+            {
+                jsonFilter(filter, keys);
+                filter_keys = keys;
+            }
+            error = deserializeJson(doc, line, DeserializationOption::Filter(filter));
+            if (error || s_type < 0 || doc["s_type"].as<int>() == s_type)
+                break;
+            s_type = -1;
+        }
+        return error;
+    }
+};
+
+//! Results per case
+struct Result {
+    double ns_unfiltered;
+    double ns_filtered;
+    double peak_unfiltered;
+    double peak_filtered;
+    double used_unfiltered;
+    double used_filtered;
+};
+
+//! Run time per line in ns
+template <typename F>
+static double measure(size_t n, F parse)
+{
+    return measureNsFor(n, MIN_TIME, [&]() {
+        for (size_t i = 0; i < n; i++)
+        {
+            parse(i);
+        }
+    });
+}
+
+/*!
+ * \brief Run both paths on lines
+ *
+ * \returns false if results differ
+ */
+static bool run(uint8_t encoder, const std::vector<std::string> &lines, Result &res)
+{
+    CountingAllocator alloc;
+    JsonDocument doc(&alloc);
+    FilteredParser fp;
+    fp.encoder = encoder;
+    size_t n = lines.size();
+    volatile float sink = 0;
+
+    // Compare results and measure memory
+    res = Result{};
+    for (size_t i = 0; i < n; i++)
+    {
+        float ref[JK_NUM];
+        float val[JK_NUM];
+        const char *line = lines[i].c_str();
+
+        alloc.resetPeak();
+        DeserializationError error = deserializeJson(doc, line);
+        if (error)
+        {
+            fprintf(stderr, "Line %zu: %s\n", i + 1, error.c_str());
+            return false;
+        }
+        res.peak_unfiltered += alloc.peak;
+        doc.shrinkToFit();
+        res.used_unfiltered += alloc.current;
+        readKeys(doc, jsonKeys(encoder, doc["s_type"].as<int>()), ref);
+        doc.clear();
+
+        uint32_t keys;
+        alloc.resetPeak();
+        error = fp.parse(doc, line, keys);
+        if (error)
+        {
+            fprintf(stderr, "Line %zu (filtered): %s\n", i + 1, error.c_str());
+            return false;
+        }
+        res.peak_filtered += alloc.peak;
+        doc.shrinkToFit();
+        res.used_filtered += alloc.current;
+        readKeys(doc, keys, val);
+        doc.clear();
+
+        if (memcmp(ref, val, sizeof(ref)) != 0)
+        {
+            fprintf(stderr, "Line %zu: results differ!\n", i + 1);
+            return false;
+        }
+    }
+    res.peak_unfiltered /= n;
+    res.peak_filtered /= n;
+    res.used_unfiltered /= n;
+    res.used_filtered /= n;
+
+    res.ns_unfiltered = measure(n, [&](size_t i) {
+        deserializeJson(doc, lines[i].c_str());
+        sink = sink + readKeys(doc, jsonKeys(encoder, doc["s_type"].as<int>()), nullptr);
+    });
+    res.ns_filtered = measure(n, [&](size_t i) {
+        uint32_t keys;
+        fp.parse(doc, lines[i].c_str(), keys);
+        sink = sink + readKeys(doc, keys, nullptr);
+    });
+    return true;
+}
+
+static void printResult(const char *name, const std::vector<std::string> &lines, const Result &r)
+{
+    size_t len = 0;
+    for (const std::string &l : lines)
+    {
+        len += l.size();
+    }
+    printf("%-14s %6zu %10.0f %10.0f %7.2f %10.0f %10.0f %10.0f %10.0f\n", name, len / lines.size(),
+           r.ns_unfiltered, r.ns_filtered, r.ns_unfiltered / r.ns_filtered,
+           r.peak_unfiltered, r.peak_filtered, r.used_unfiltered, r.used_filtered);
+}
+
+static void printHeader(void)
+{
+    printf("%-14s %6s %10s %10s %7s %10s %10s %10s %10s\n", "", "Line", "Unfiltered", "Filtered", "",
+           "Peak [B]", "Peak [B]", "Doc [B]", "Doc [B]");
+    printf("%-14s %6s %10s %10s %7s %10s %10s %10s %10s\n", "Case", "[B]", "[ns]", "[ns]", "Speedup",
+           "unfiltered", "filtered", "unfiltered", "filtered");
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [-n <lines>]\n", name);
+    fprintf(stderr, "       %s -x <encoder> <json_file>\n", name);
+}
+
+int main(int argc, char *argv[])
+{
+    int opt;
+    long n_lines = DEFAULT_LINES;
+    int encoder = -1;
+
+    while ((opt = getopt(argc, argv, "n:x:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                n_lines = atol(optarg);
+                break;
+            case 'x':
+                for (size_t i = 0; i < sizeof(encoder_names) / sizeof(encoder_names[0]); i++)
+                {
+                    if (strcmp(optarg, encoder_names[i]) == 0)
+                    {
+                        encoder = i;
+                    }
+                }
+                if (encoder < 0)
+                {
+                    fprintf(stderr, "Unknown encoder %s\n", optarg);
+                    return 1;
+                }
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (n_lines < 1 || (optind < argc && encoder < 0) || (encoder >= 0 && optind >= argc))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    Result res;
+
+    // Captured lines
+    if (optind < argc)
+    {
+        FILE *f = fopen(argv[optind], "r");
+        if (!f)
+        {
+            perror(argv[optind]);
+            return 1;
+        }
+        std::vector<std::string> lines;
+        char buf[1024];
+        while (fgets(buf, sizeof(buf), f))
+        {
+            buf[strcspn(buf, "\r\n")] = '\0';
+            if (buf[0] == '{')
+            {
+                lines.push_back(buf);
+            }
+        }
+        fclose(f);
+        if (lines.empty())
+        {
+            fprintf(stderr, "No JSON lines found!\n");
+            return 1;
+        }
+        if (!run(encoder, lines, res))
+        {
+            return 1;
+        }
+        printHeader();
+        printResult(encoder_names[encoder], lines, res);
+        return 0;
+    }
+
+    // Synthetic lines
+    printHeader();
+    for (const Case &c : cases)
+    {
+        std::vector<std::string> lines;
+        rng.seed(1);
+        for (long i = 0; i < n_lines; i++)
+        {
+            lines.push_back(genLine(c, i));
+        }
+        if (!run(c.encoder, lines, res))
+        {
+            fprintf(stderr, "%s failed!\n", c.name);
+            return 1;
+        }
+        printResult(c.name, lines, res);
+    }
+    return 0;
+}
@@ -0,0 +1,242 @@
+///////////////////////////////////////////////////////////////////////////////
+// kernel_bench.cpp
+//
+// Host benchmark - payload kernels (PayloadKernels.h) vs. byte-wise loops
+//
+// The 5-in-1 checksum (number of bits set in bytes 14...25) and inversion
+// (bytes 0...12 = ~bytes 13...25) are computed from random payloads
+// - byte by byte with a shift-and-add loop (as before PayloadKernels.h),
+// - with bitCountNibble() and
+// - with bitCountPopcount() (the hardware instruction is only used if the
+//   compiler targets it, e.g. -mpopcnt or -march=native on x86).
+// Data whitening is compared with a byte-wise XOR loop.
+// Before the measurement, the output of all variants is compared.
+//
+// Build (Linux):
+//   g++ -std=c++17 -O2 -Wall -I../.. -o kernel_bench kernel_bench.cpp
+//   g++ -std=c++17 -O2 -mpopcnt -Wall -I../.. -o kernel_bench kernel_bench.cpp
+//   (in extras/kernel_bench)
+//
+// Usage:
+//   kernel_bench [<rounds>]
+//
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          PRNG and time measurement from ../common/BenchHarness.h
+//
+// ToDo:
+// -
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "PayloadKernels.h"
+#include "../common/BenchHarness.h"
+
+#define PAYLOADS    4096        //!< number of random payloads
+#define PAYLOAD_LEN 26          //!< 5-in-1 payload size
+
+#define NOINLINE __attribute__((noinline))
+
+//! Payload
+typedef uint8_t Payload[PAYLOAD_LEN];
+
+static XorShift32 rng;
+
+//
+// 5-in-1 checksum and inversion
+//
+NOINLINE static void checksumLoop(uint8_t *payload)
+{
+    uint8_t bitsSet = 0;
+
+    for (uint8_t p = 14; p < 26; p++)
+    {
+        uint8_t currentByte = payload[p];
+        while (currentByte)
+        {
+            bitsSet += (currentByte & 1);
+            currentByte >>= 1;
+        }
+    }
+    payload[13] = bitsSet;
+
+    for (unsigned col = 0; col < 26 / 2; ++col)
+    {
+        payload[col] = ~payload[col + 13];
+    }
+}
+
+NOINLINE static void checksumNibble(uint8_t *payload)
+{
+    payload[13] = bitCountNibble(&payload[14], 12);
+    invertBytes(payload, &payload[13], 13);
+}
+
+NOINLINE static void checksumPopcount(uint8_t *payload)
+{
+    payload[13] = bitCountPopcount(&payload[14], 12);
+    invertBytes(payload, &payload[13], 13);
+}
+
+//
+// Data whitening
+//
+NOINLINE static void whitenLoop(uint8_t *payload)
+{
+    for (unsigned i = 0; i < PAYLOAD_LEN; i++)
+    {
+        payload[i] ^= 0xAA;
+    }
+}
+
+NOINLINE static void whitenWord(uint8_t *payload)
+{
+    whiten(payload, PAYLOAD_LEN, 0xAA);
+}
+
+//! Kernel under test
+struct Kernel {
+    const char *name;
+    void (*run)(uint8_t *payload);
+};
+
+static const Kernel checksumKernels[] = {
+    {"checksum-loop", checksumLoop},
+    {"checksum-nibble", checksumNibble},
+    {"checksum-popcount", checksumPopcount}
+};
+
+static const Kernel whitenKernels[] = {
+    {"whiten-loop", whitenLoop},
+    {"whiten-word", whitenWord}
+};
+
+//! Time per payload in ns
+static double measure(std::vector<Payload> &payloads, size_t rounds,
+                      void (*run)(uint8_t *payload), uint32_t &sink)
+{
+    size_t r = 0;
+    return measureNs(payloads.size(), rounds, [&]() {
+        for (Payload &p : payloads)
+        {
+            run(p);
+            sink += p[r % PAYLOAD_LEN];
+        }
+        r++;
+    });
+}
+
+//! Compare all kernels with the first one, measure and print results
+static bool run(const Kernel *kernels, size_t n, const std::vector<Payload> &input,
+                size_t rounds, uint32_t &sink)
+{
+    // All variants must provide identical payloads
+    for (const Payload &in : input)
+    {
+        Payload ref;
+        memcpy(ref, in, PAYLOAD_LEN);
+        kernels[0].run(ref);
+        for (size_t k = 1; k < n; k++)
+        {
+            Payload p;
+            memcpy(p, in, PAYLOAD_LEN);
+            kernels[k].run(p);
+            if (memcmp(p, ref, PAYLOAD_LEN) != 0)
+            {
+                fprintf(stderr, "%s: payloads differ from %s!\n", kernels[k].name, kernels[0].name);
+                return false;
+            }
+        }
+    }
+
+    // Alternating measurements, minimum of each variant
+    std::vector<Payload> payloads(input.size());
+    memcpy(payloads.data(), input.data(), input.size() * sizeof(Payload));
+    std::vector<double> t(n, 1e9);
+    for (int i = 0; i < 10; i++)
+    {
+        for (size_t k = 0; k < n; k++)
+        {
+            t[k] = std::min(t[k], measure(payloads, rounds / 10 + 1, kernels[k].run, sink));
+        }
+    }
+    for (size_t k = 0; k < n; k++)
+    {
+        printf("%-18s %12.2f %8.2f\n", kernels[k].name, t[k], t[k] / t[0]);
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t rounds = (argc > 1) ? atol(argv[1]) : 1000;
+    if (rounds < 1)
+    {
+        fprintf(stderr, "Number of rounds must be >= 1!\n");
+        return 1;
+    }
+
+    std::vector<Payload> input(PAYLOADS);
+    for (Payload &p : input)
+    {
+        for (unsigned i = 0; i < PAYLOAD_LEN; i++)
+        {
+            p[i] = rng.next() & 0xFF;
+        }
+    }
+
+#if defined(PAYLOAD_KERNELS_HW_POPCOUNT)
+    printf("bitCount(): bitCountPopcount() (hardware population count)\n");
+#else
+    printf("bitCount(): bitCountNibble() (no hardware population count)\n");
+#endif
+
+    uint32_t sink = 0;
+
+    printf("%-18s %12s %8s\n", "Kernel", "Time [ns]", "Ratio");
+    if (!run(checksumKernels, sizeof(checksumKernels) / sizeof(checksumKernels[0]), input, rounds, sink))
+    {
+        return 1;
+    }
+    if (!run(whitenKernels, sizeof(whitenKernels) / sizeof(whitenKernels[0]), input, rounds, sink))
+    {
+        return 1;
+    }
+
+    return (sink == 0xFFFFFFFF);
+}
@@ -0,0 +1,368 @@
+///////////////////////////////////////////////////////////////////////////////
+// layout_bench.cpp
+//
+// Host benchmark - declarative payload layouts (PayloadLayout.h) vs.
+// hand-written bit packing
+//
+// For each encoder, the payload fields are packed from the same values
+// - by the layouts from PayloadEncoders.h and
+// - by hand-written shift/or code.
+// The hand-written code provides the same guarantees as the layouts: each
+// value is limited to its field width and partially covered bytes are
+// ORed (fields of other layouts may share these bytes).
+// Before the measurement, the output of both variants is compared.
+// Checksums/digests are not included, since they do not depend on the
+// method of packing.
+//
+// Build (Linux):
+//   g++ -std=c++17 -O2 -Wall -I../.. -o layout_bench layout_bench.cpp
+//   (in extras/layout_bench)
+//
+// Usage:
+//   layout_bench [<rounds>]
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Hand-written reference with field width masking (like-for-like)
+//          50 alternating measurements
+//          PRNG and time measurement from ../common/BenchHarness.h
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "PayloadEncoders.h"
+#include "../common/BenchHarness.h"
+
+#define VALUE_SETS  4096        //!< number of value sets per encoder
+#define MAX_VALUES  32          //!< max. number of values per set
+
+#define NOINLINE __attribute__((noinline))
+
+//! Value set
+typedef uint32_t Values[MAX_VALUES];
+
+static XorShift32 rng;
+
+//! Two BCD digits
+static inline uint8_t bcd(uint32_t v)
+{
+    return ((v / 10 % 10) << 4) | (v % 10);
+}
+
+//
+// Bresser 5-in-1
+//
+static void gen5In1(Values &v)
+{
+    v[B5_ID] = rng.below(256);
+    v[B5_NSTARTUP] = rng.below(2);
+    v[B5_STYPE] = rng.below(16);
+    v[B5_GUST] = rng.below(4096);
+    v[B5_WDIR] = rng.below(16);
+    v[B5_WAVG] = rng.below(1000);
+    v[B5_TEMP] = rng.below(1000);
+    v[B5_TSIGN] = rng.below(2);
+    v[B5_HUM] = rng.below(100);
+    v[B5_RAIN] = rng.below(10000);
+    v[B5_NBATT] = rng.below(2);
+}
+
+NOINLINE static void hand5In1(uint8_t *payload, const Values &v)
+{
+    payload[14] = v[B5_ID];
+    payload[15] |= ((v[B5_NSTARTUP] & 1) << 7) | (v[B5_STYPE] & 0xF);
+    payload[16] = v[B5_GUST];
+    payload[17] = ((v[B5_WDIR] & 0xF) << 4) | ((v[B5_GUST] >> 8) & 0xF);
+    payload[18] = bcd(v[B5_WAVG]);
+    payload[19] |= v[B5_WAVG] / 100 % 10;
+    payload[20] = bcd(v[B5_TEMP]);
+    payload[21] |= v[B5_TEMP] / 100 % 10;
+    payload[22] = bcd(v[B5_HUM]);
+    payload[23] = bcd(v[B5_RAIN]);
+    payload[24] = bcd(v[B5_RAIN] / 100);
+    payload[25] |= ((v[B5_NBATT] & 1) << 7) | (v[B5_TSIGN] & 1);
+}
+
+NOINLINE static void layout5In1(uint8_t *payload, const Values &v)
+{
+    Bresser5In1Layout::pack(payload, v);
+}
+
+//
+// Bresser 6-in-1 (temperature/humidity message)
+//
+static void gen6In1(Values &v)
+{
+    v[B6_ID] = rng.below(0xFFFFFFFF);
+    v[B6_STYPE] = rng.below(16);
+    v[B6_NSTARTUP] = rng.below(2);
+    v[B6_CHAN] = rng.below(8);
+    v[B6_GUST] = rng.below(1000);
+    v[B6_WAVG] = rng.below(1000);
+    v[B6_WDIR] = rng.below(360);
+    v[B6_UV] = rng.below(160);
+    v[B6_TEMP] = rng.below(1000);
+    v[B6_TNEG] = rng.below(2);
+    v[B6_BATT] = rng.below(2);
+    v[B6_HUM] = rng.below(100);
+}
+
+NOINLINE static void hand6In1(uint8_t *payload, const Values &v)
+{
+    payload[2] = v[B6_ID] >> 24;
+    payload[3] = (v[B6_ID] >> 16) & 0xFF;
+    payload[4] = (v[B6_ID] >> 8) & 0xFF;
+    payload[5] = v[B6_ID] & 0xFF;
+    payload[6] = ((v[B6_STYPE] & 0xF) << 4) | ((v[B6_NSTARTUP] & 1) << 3) | (v[B6_CHAN] & 7);
+    payload[7] = ~bcd(v[B6_GUST] / 10);
+    payload[8] = ~(((v[B6_GUST] % 10) << 4) | (v[B6_WAVG] % 10));
+    payload[9] = ~bcd(v[B6_WAVG] / 10);
+    payload[10] = bcd(v[B6_WDIR] / 10);
+    payload[11] |= (v[B6_WDIR] % 10) << 4;
+    payload[12] = bcd(v[B6_TEMP] / 10);
+    payload[13] |= ((v[B6_TEMP] % 10) << 4) | ((v[B6_TNEG] & 1) << 3) | ((v[B6_BATT] & 1) << 1);
+    payload[14] = bcd(v[B6_HUM]);
+    payload[15] = ~bcd(v[B6_UV] / 10);
+    payload[16] |= ((v[B6_UV] % 10) << 4) ^ 0xF0;
+}
+
+NOINLINE static void layout6In1(uint8_t *payload, const Values &v)
+{
+    Bresser6In1CommonLayout::pack(payload, v);
+    Bresser6In1TempLayout::pack(payload, v);
+}
+
+//
+// Bresser 7-in-1 (weather sensor)
+//
+static void gen7In1(Values &v)
+{
+    v[B7_ID] = rng.below(0x10000);
+    v[B7_STYPE] = rng.below(16);
+    v[B7_NSTARTUP] = rng.below(2);
+    v[B7_CHAN] = rng.below(8);
+    v[B7_FLAGS] = rng.below(2) * 6;
+    v[B7_WDIR] = rng.below(360);
+    v[B7_GUST] = rng.below(1000);
+    v[B7_WAVG] = rng.below(1000);
+    v[B7_RAIN] = rng.below(1000000);
+    v[B7_TEMP] = rng.below(1000);
+    v[B7_HUM] = rng.below(100);
+    v[B7_LIGHT] = rng.below(200000);
+    v[B7_UV] = rng.below(160);
+}
+
+NOINLINE static void hand7In1(uint8_t *payload, const Values &v)
+{
+    payload[2] = (v[B7_ID] >> 8) & 0xFF;
+    payload[3] = v[B7_ID] & 0xFF;
+    payload[4] = bcd(v[B7_WDIR] / 10);
+    payload[5] |= (v[B7_WDIR] % 10) << 4;
+    // STYPE, STARTUP and CH are not covered by whitening
+    payload[6] = (((v[B7_STYPE] & 0xF) << 4) | ((v[B7_NSTARTUP] & 1) << 3) | (v[B7_CHAN] & 7)) ^ WHITENING_BRESSER_7IN1;
+    payload[7] = bcd(v[B7_GUST] / 10);
+    payload[8] = ((v[B7_GUST] % 10) << 4) | (v[B7_WAVG] / 100 % 10);
+    payload[9] = bcd(v[B7_WAVG]);
+    payload[10] = bcd(v[B7_RAIN] / 10000);
+    payload[11] = bcd(v[B7_RAIN] / 100);
+    payload[12] = bcd(v[B7_RAIN]);
+    payload[14] = bcd(v[B7_TEMP] / 10);
+    payload[15] = ((v[B7_TEMP] % 10) << 4) | (v[B7_FLAGS] & 0xF);
+    payload[16] = bcd(v[B7_HUM]);
+    payload[17] = bcd(v[B7_LIGHT] / 10000);
+    payload[18] = bcd(v[B7_LIGHT] / 100);
+    payload[19] = bcd(v[B7_LIGHT]);
+    payload[20] = bcd(v[B7_UV] / 10);
+    payload[21] |= (v[B7_UV] % 10) << 4;
+}
+
+NOINLINE static void layout7In1(uint8_t *payload, const Values &v)
+{
+    Bresser7In1Layout::pack(payload, v);
+    Bresser7In1WeatherLayout::pack(payload, v);
+}
+
+//
+// Bresser Lightning
+//
+static void genLightning(Values &v)
+{
+    uint32_t count = rng.below(1600);
+
+    v[BL_ID] = rng.below(0x10000);
+    v[BL_CTR_HI] = count / 100;
+    v[BL_CTR] = count;
+    v[BL_BATT] = rng.below(2) * 8;
+    v[BL_STYPE] = SENSOR_TYPE_LIGHTNING;
+    v[BL_STARTUP] = rng.below(2) * 8;
+    v[BL_KM] = rng.below(41);
+}
+
+NOINLINE static void handLightning(uint8_t *payload, const Values &v)
+{
+    payload[2] = (v[BL_ID] >> 8) & 0xFF;
+    payload[3] = v[BL_ID] & 0xFF;
+    payload[4] = ((v[BL_CTR_HI] & 0xF) << 4) | (v[BL_CTR] / 10 % 10);
+    // BATT is not covered by whitening
+    payload[5] = ((v[BL_CTR] % 10) << 4) | ((v[BL_BATT] & 0xF) ^ (WHITENING_BRESSER_LIGHTNING & 0x0F));
+    // STYPE and STARTUP are not covered by whitening
+    payload[6] = (((v[BL_STYPE] & 0xF) << 4) | (v[BL_STARTUP] & 0xF)) ^ WHITENING_BRESSER_LIGHTNING;
+    payload[7] = v[BL_KM];
+}
+
+NOINLINE static void layoutLightning(uint8_t *payload, const Values &v)
+{
+    BresserLightningLayout::pack(payload, v);
+}
+
+//
+// Bresser Water Leakage
+//
+static void genLeakage(Values &v)
+{
+    v[BW_ID] = rng.below(0xFFFFFFFF);
+    v[BW_STYPE] = SENSOR_TYPE_LEAKAGE;
+    v[BW_NSTARTUP] = rng.below(2);
+    v[BW_CHAN] = rng.below(8);
+    v[BW_ALARM] = rng.below(2);
+    v[BW_NALARM] = !v[BW_ALARM];
+    v[BW_BATT] = rng.below(2) * 3;
+}
+
+NOINLINE static void handLeakage(uint8_t *payload, const Values &v)
+{
+    payload[2] = v[BW_ID] >> 24;
+    payload[3] = (v[BW_ID] >> 16) & 0xFF;
+    payload[4] = (v[BW_ID] >> 8) & 0xFF;
+    payload[5] = v[BW_ID] & 0xFF;
+    payload[6] = ((v[BW_STYPE] & 0xF) << 4) | ((v[BW_NSTARTUP] & 1) << 3) | (v[BW_CHAN] & 7);
+    payload[7] |= ((v[BW_ALARM] & 1) << 7) | ((v[BW_NALARM] & 1) << 6) | ((v[BW_BATT] & 3) << 4);
+}
+
+NOINLINE static void layoutLeakage(uint8_t *payload, const Values &v)
+{
+    BresserLeakageLayout::pack(payload, v);
+}
+
+//! Encoder under test
+struct Encoder {
+    const char *name;
+    void (*gen)(Values &v);
+    void (*hand)(uint8_t *payload, const Values &v);
+    void (*layout)(uint8_t *payload, const Values &v);
+    uint8_t size;
+};
+
+static const Encoder encoders[] = {
+    {"bresser-5in1", gen5In1, hand5In1, layout5In1, 26},
+    {"bresser-6in1", gen6In1, hand6In1, layout6In1, 18},
+    {"bresser-7in1", gen7In1, hand7In1, layout7In1, 26},
+    {"bresser-lightning", genLightning, handLightning, layoutLightning, 10},
+    {"bresser-leakage", genLeakage, handLeakage, layoutLeakage, 10}
+};
+
+//! Time per payload in ns
+static double measure(const std::vector<Values> &values, size_t rounds, uint8_t size,
+                      void (*pack)(uint8_t *payload, const Values &v), uint32_t &sink)
+{
+    uint8_t payload[26];
+
+    size_t r = 0;
+    return measureNs(values.size(), rounds, [&]() {
+        for (const Values &v : values)
+        {
+            memset(payload, 0, size);
+            pack(payload, v);
+            sink += payload[r % size];
+        }
+        r++;
+    });
+}
+
+int main(int argc, char *argv[])
+{
+    size_t rounds = (argc > 1) ? atol(argv[1]) : 1000;
+    if (rounds < 1)
+    {
+        fprintf(stderr, "Number of rounds must be >= 1!\n");
+        return 1;
+    }
+
+    std::vector<Values> values(VALUE_SETS);
+    uint32_t sink = 0;
+
+    printf("%-18s %12s %12s %8s\n", "Encoder", "Hand [ns]", "Layout [ns]", "Ratio");
+    for (const Encoder &enc : encoders)
+    {
+        rng.seed(1);
+        for (Values &v : values)
+        {
+            memset(v, 0, sizeof(v));
+            enc.gen(v);
+        }
+
+        // Both variants must provide identical payloads
+        for (const Values &v : values)
+        {
+            uint8_t hand[26] = {0};
+            uint8_t layout[26] = {0};
+            enc.hand(hand, v);
+            enc.layout(layout, v);
+            if (memcmp(hand, layout, enc.size) != 0)
+            {
+                fprintf(stderr, "%s: payloads differ!\n", enc.name);
+                return 1;
+            }
+        }
+
+        // Alternating measurements, minimum of each variant
+        double t_hand = 1e9;
+        double t_layout = 1e9;
+        for (int i = 0; i < 50; i++)
+        {
+            t_hand = std::min(t_hand, measure(values, rounds / 50 + 1, enc.size, enc.hand, sink));
+            t_layout = std::min(t_layout, measure(values, rounds / 50 + 1, enc.size, enc.layout, sink));
+        }
+        printf("%-18s %12.2f %12.2f %8.2f\n", enc.name, t_hand, t_layout, t_layout / t_hand);
+    }
+
+    return (sink == 0xFFFFFFFF);
+}
@@ -0,0 +1,288 @@
+///////////////////////////////////////////////////////////////////////////////
+// queue_bench.cpp
+//
+// Host benchmark - command queue (CommandQueue.h) with many producers
+//
+// 1, 2, 4... <producers> threads enqueue commands into one queue with
+// COMMAND_QUEUE_SIZE cells (see SensorTransmitter.h), one thread dequeues
+// them. A producer yields and retries while the queue is full.
+// Reported per number of producers:
+// - throughput (commands/s through the queue)
+// - enqueue latency (one successful push() - percentiles and max.)
+// - rejected pushes (queue full) per command
+// The same is measured for a ring buffer protected by a std::mutex.
+// Each command carries the producer index and a sequence number; the
+// consumer verifies that no command is lost or duplicated and that the
+// commands of each producer arrive in order.
+//
+// The latency is measured with the time stamp counter (calibrated against
+// steady_clock); it includes preemption of the producer, so the max. values
+// depend on the load of the host.
+//
+// Build (Linux):
+//   g++ -std=c++17 -O2 -Wall -pthread -I../.. -o queue_bench queue_bench.cpp
+//   (in extras/queue_bench)
+//
+// Usage:
+//   queue_bench [-p <producers>] [-n <commands per producer>]
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <x86intrin.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CommandQueue.h"
+
+#define COMMAND_QUEUE_SIZE 16   //!< command queue entries (see SensorTransmitter.h)
+
+/*!
+ * \brief Ring buffer protected by a mutex - for comparison
+ */
+template <typename T, size_t N>
+class MutexQueue {
+public:
+    bool push(const T &item)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_tail - _head == N)
+        {
+            _dropped++;
+            return false;
+        }
+        _item[_tail++ % N] = item;
+        return true;
+    }
+
+    bool pop(T &item)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_head == _tail)
+        {
+            return false;
+        }
+        item = _item[_head++ % N];
+        return true;
+    }
+
+    uint32_t dropped(void) const
+    {
+        return _dropped;
+    }
+
+private:
+    std::mutex _mutex;
+    T _item[N];
+    uint32_t _tail = 0;
+    uint32_t _head = 0;
+    uint32_t _dropped = 0;
+};
+
+//! Result of one run
+struct Result {
+    double seconds;             //!< wall clock time
+    double p50, p99, max;       //!< enqueue latency in ns
+    double rejected;            //!< rejected pushes per command
+    bool ok;                    //!< all commands received in order
+};
+
+//! Time stamp counter ticks per ns
+static double ticks_per_ns;
+
+static void calibrate(void)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t c0 = __rdtsc();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    uint64_t c1 = __rdtsc();
+    std::chrono::duration<double, std::nano> t = std::chrono::steady_clock::now() - t0;
+    ticks_per_ns = (c1 - c0) / t.count();
+}
+
+/*!
+ * \brief Run producers and consumer
+ *
+ * \param producers     number of producer threads
+ * \param n             commands per producer
+ */
+template <typename Q>
+static Result run(unsigned producers, uint32_t n)
+{
+    Q queue;
+    std::vector<std::vector<uint32_t>> latency(producers);
+    std::atomic<unsigned> ready{0};
+    std::atomic<bool> go{false};
+    bool ok = true;
+
+    std::thread consumer([&]() {
+        std::vector<uint32_t> next(producers, 0);
+        uint64_t total = (uint64_t)producers * n;
+        Command c;
+        while (total > 0)
+        {
+            if (!queue.pop(c))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            // value: producer index (8 bits), sequence number (24 bits)
+            unsigned p = c.value >> 24;
+            if (c.type != CommandType::INTERVAL || p >= producers || (c.value & 0xFFFFFF) != next[p])
+            {
+                ok = false;
+            }
+            else
+            {
+                next[p]++;
+            }
+            total--;
+        }
+    });
+
+    std::vector<std::thread> pool;
+    for (unsigned p = 0; p < producers; p++)
+    {
+        latency[p].resize(n);
+        pool.emplace_back([&, p]() {
+            ready++;
+            while (!go)
+            {
+                std::this_thread::yield();
+            }
+            for (uint32_t i = 0; i < n; i++)
+            {
+                Command c = Command::interval(p << 24 | i);
+                uint64_t t0 = __rdtsc();
+                while (!queue.push(c))
+                {
+                    // Full - wait for the consumer; the latency of the successful push is measured
+                    std::this_thread::yield();
+                    t0 = __rdtsc();
+                }
+                latency[p][i] = __rdtsc() - t0;
+            }
+        });
+    }
+
+    while (ready < producers)
+    {
+        std::this_thread::yield();
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    go = true;
+    for (std::thread &th : pool)
+    {
+        th.join();
+    }
+    consumer.join();
+    std::chrono::duration<double> t = std::chrono::steady_clock::now() - t0;
+
+    std::vector<uint32_t> all;
+    all.reserve((size_t)producers * n);
+    for (const std::vector<uint32_t> &l : latency)
+    {
+        all.insert(all.end(), l.begin(), l.end());
+    }
+    std::sort(all.begin(), all.end());
+
+    Result r;
+    r.seconds = t.count();
+    r.p50 = all[all.size() / 2] / ticks_per_ns;
+    r.p99 = all[all.size() * 99 / 100] / ticks_per_ns;
+    r.max = all.back() / ticks_per_ns;
+    r.rejected = (double)queue.dropped() / all.size();
+    r.ok = ok;
+    return r;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned max_producers = std::max(16U, 2 * std::thread::hardware_concurrency());
+    uint32_t n = 200000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_arg = (i + 1 < argc);
+        if (strcmp(argv[i], "-p") == 0 && has_arg)
+        {
+            max_producers = std::min(255, std::max(1, atoi(argv[++i])));
+        }
+        else if (strcmp(argv[i], "-n") == 0 && has_arg)
+        {
+            n = std::min(0xFFFFFF, std::max(1, atoi(argv[++i])));
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [-p <producers>] [-n <commands per producer>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    calibrate();
+    printf("Queue: %d cells, command %zu bytes, %s, hardware threads: %u, %u commands per producer\n\n",
+           COMMAND_QUEUE_SIZE, sizeof(Command),
+           std::atomic<uint32_t>().is_lock_free() ? "lock-free" : "not lock-free",
+           std::thread::hardware_concurrency(), n);
+    printf("Queue       Producers  Commands/s   Enqueue p50 [ns]   p99 [ns]    max [ns]  Rejected/cmd  Order\n");
+
+    bool pass = true;
+    for (int q = 0; q < 2; q++)
+    {
+        for (unsigned p = 1;; p = std::min(2 * p, max_producers))
+        {
+            Result r = (q == 0) ? run<MpscQueue<Command, COMMAND_QUEUE_SIZE>>(p, n)
+                                : run<MutexQueue<Command, COMMAND_QUEUE_SIZE>>(p, n);
+            printf("%-10s %10u %11.4g %18.0f %10.0f %11.0f %13.2f  %s\n", (q == 0) ? "MpscQueue" : "std::mutex",
+                   p, (double)p * n / r.seconds, r.p50, r.p99, r.max, r.rejected, r.ok ? "ok" : "FAILED");
+            pass &= r.ok;
+            if (p == max_producers)
+            {
+                break;
+            }
+        }
+    }
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,756 @@
+///////////////////////////////////////////////////////////////////////////////
+// rtl433_replay.cpp
+//
+// Replay of recorded sensor data (JSON lines, e.g. from rtl_433 -F json)
+// with original timing to SensorTransmitter via serial port or to stdout
+//
+// The log file is memory mapped and split into lines in place - the file
+// is never loaded into memory as a whole, so multi-GB captures can be
+// replayed. Lines which do not start with '{' are skipped.
+//
+// The relative timing of the frames is taken from the "time" field, which
+// may contain
+// - "YYYY-MM-DD HH:MM:SS[.ffffff]" (rtl_433 default) or ISO 8601 with 'T'
+// - Unix time in seconds (rtl_433 -M time:unix[:usec])
+// Lines without timestamp are sent immediately after the previous one.
+//
+// SensorTransmitter must use DATA_JSON_INPUT and should be set to
+// 'trigger=input' to transmit each frame on arrival.
+//
+// With -x <encoder>, the lines are not forwarded but encoded on the host like
+// by deSerialize()/jsonSensor() in the sketch - the keys consumed by the
+// encoder and sensor type (JsonFilter.h) update the record of the sensor
+// (by sensor_id) through the field table (SensorFields.h), then the frame is
+// encoded with the encoders from PayloadEncoders.h. The frames are written
+// to stdout in the frame file format of fsk_mod (start time in s relative to
+// the first line and frame as hex string).
+//
+// Build (Linux):
+//   g++ -std=c++17 -O2 -Wall -I../.. -o rtl433_replay rtl433_replay.cpp
+//   (in extras/replay)
+//
+// Usage:
+//   rtl433_replay [-s <speed>] [-d <device>] [-b <baud>] [-m <max_len>] [-n] <logfile>
+//   rtl433_replay [-s <speed>] [-x <encoder>] [-m <max_len>] [-n] <logfile> > <frame_file>
+//
+//   -s <speed>     replay speed 1...1000 (default: 1, i.e. real time)
+//   -d <device>    serial port (default: stdout)
+//   -b <baud>      baud rate (default: 115200)
+//   -m <max_len>   max. line length; longer lines are skipped (default: 2048,
+//                  see MAX_LINE_LENGTH in SensorTransmitter.h)
+//   -n             no pacing - send as fast as possible
+//   -x <encoder>   encode frames: bresser-5in1, bresser-6in1, bresser-7in1,
+//                  bresser-lightning or bresser-leakage
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Default max. line length: 2048 (see MAX_LINE_LENGTH)
+//          Added encoding of the lines on the host (-x <encoder>)
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <unordered_map>
+
+#include "SensorBatch.h"
+#include "SensorFields.h"
+
+// Pages behind the read position are released in chunks of this size
+#define RELEASE_CHUNK (64UL * 1024 * 1024)
+
+/*!
+ * \brief Memory mapped file with in-place line splitter
+ */
+class LineSource {
+public:
+    LineSource() : _data(nullptr), _size(0), _pos(0), _released(0)
+    {
+    }
+
+    ~LineSource()
+    {
+        if (_data)
+        {
+            munmap((void *)_data, _size);
+        }
+    }
+
+    bool open(const char *path)
+    {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            perror(path);
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) < 0)
+        {
+            perror(path);
+            close(fd);
+            return false;
+        }
+        _size = st.st_size;
+        if (_size > 0)
+        {
+            void *p = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED)
+            {
+                perror("mmap");
+                close(fd);
+                return false;
+            }
+            _data = (const char *)p;
+            madvise(p, _size, MADV_SEQUENTIAL);
+        }
+        close(fd);
+        return true;
+    }
+
+    /*!
+     * \brief Next line
+     *
+     * \param line  start of line (not NUL-terminated)
+     * \param len   length of line without line terminator
+     *
+     * \returns false at end of file
+     */
+    bool next(const char *&line, size_t &len)
+    {
+        if (_pos >= _size)
+        {
+            return false;
+        }
+        line = _data + _pos;
+        const char *nl = (const char *)memchr(line, '\n', _size - _pos);
+        len = nl ? (size_t)(nl - line) : _size - _pos;
+        _pos += len + 1;
+        if (len > 0 && line[len - 1] == '\r')
+        {
+            len--;
+        }
+
+        // Drop pages already read from the mapping
+        if (_pos - _released >= RELEASE_CHUNK + (size_t)sysconf(_SC_PAGESIZE))
+        {
+            size_t page = sysconf(_SC_PAGESIZE);
+            size_t end = (_pos - RELEASE_CHUNK / 2) & ~(page - 1);
+            madvise((void *)(_data + _released), end - _released, MADV_DONTNEED);
+            _released = end;
+        }
+        return true;
+    }
+
+private:
+    const char *_data;
+    size_t _size;
+    size_t _pos;
+    size_t _released;
+};
+
+//! Encoder
+struct Protocol {
+    const char *name;
+    uint8_t encoder;            //!< index: Encoders (see jsonKeys())
+    uint8_t size;
+    uint8_t whitening;
+    uint8_t s_type;             //!< sensor type of new records
+    uint8_t (*encode)(uint8_t *payload, const SensorRecord &rec);
+};
+
+static const Protocol protocols[] = {
+    {"bresser-5in1", 0, 26, 0, SENSOR_TYPE_WEATHER0, encodeBresser5In1<SensorRecord>},
+    {"bresser-6in1", 1, 18, 0, SENSOR_TYPE_WEATHER1, encodeBresser6In1Record},
+    {"bresser-7in1", 2, 26, WHITENING_BRESSER_7IN1, SENSOR_TYPE_WEATHER1, encodeBresser7In1<SensorRecord>},
+    {"bresser-leakage", 3, 10, 0, SENSOR_TYPE_LEAKAGE, encodeBresserLeakage<SensorRecord>},
+    {"bresser-lightning", 4, 10, WHITENING_BRESSER_LIGHTNING, SENSOR_TYPE_LIGHTNING, encodeBresserLightning<SensorRecord>}
+};
+
+/*!
+ * \brief Get timestamp from "time" field
+ *
+ * \param line  JSON line
+ * \param len   line length
+ * \param us    timestamp in microseconds
+ *
+ * \returns true if timestamp found
+ */
+static bool parseTime(const char *line, size_t len, int64_t &us)
+{
+    static const char key[] = "\"time\"";
+    const char *end = line + len;
+    const char *p = (const char *)memmem(line, len, key, sizeof(key) - 1);
+    if (!p)
+    {
+        return false;
+    }
+    p += sizeof(key) - 1;
+    while (p < end && (*p == ' ' || *p == ':'))
+    {
+        p++;
+    }
+    bool quoted = (p < end && *p == '"');
+    if (quoted)
+    {
+        p++;
+    }
+
+    // Copy value - the mapping is not NUL-terminated
+    char buf[40];
+    size_t n = 0;
+    while (p < end && n < sizeof(buf) - 1 && *p != '"' && *p != ',' && *p != '}')
+    {
+        buf[n++] = *p++;
+    }
+    buf[n] = '\0';
+
+    struct tm tm;
+    memset(&tm, 0, sizeof(tm));
+    int frac_pos = -1;
+    int consumed = 0;
+    if (sscanf(buf, "%d-%d-%d%*[ T]%d:%d:%d%n", &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+               &tm.tm_hour, &tm.tm_min, &tm.tm_sec, &consumed) == 6)
+    {
+        tm.tm_year -= 1900;
+        tm.tm_mon -= 1;
+        us = (int64_t)timegm(&tm) * 1000000;
+        frac_pos = consumed;
+    }
+    else
+    {
+        char *e;
+        long long s = strtoll(buf, &e, 10);
+        if (e == buf)
+        {
+            return false;
+        }
+        us = (int64_t)s * 1000000;
+        frac_pos = e - buf;
+    }
+
+    // Fractional seconds
+    if (buf[frac_pos] == '.')
+    {
+        int64_t scale = 100000;
+        for (const char *f = &buf[frac_pos + 1]; *f >= '0' && *f <= '9' && scale > 0; f++, scale /= 10)
+        {
+            us += (*f - '0') * scale;
+        }
+    }
+    return true;
+}
+
+//! Member with known key and numeric value
+struct Member {
+    uint8_t key;                //!< key index (JsonKey)
+    double value;
+};
+
+static const char *skipSpace(const char *p, const char *end)
+{
+    while (p < end && (*p == ' ' || *p == '\t'))
+    {
+        p++;
+    }
+    return p;
+}
+
+//! Skip string, object, array or literal
+static const char *skipValue(const char *p, const char *end)
+{
+    int depth = 0;
+    bool quoted = false;
+    for (; p < end; p++)
+    {
+        if (quoted)
+        {
+            if (*p == '\\')
+            {
+                p++;
+            }
+            else if (*p == '"')
+            {
+                quoted = false;
+                if (depth == 0)
+                {
+                    return p + 1;
+                }
+            }
+        }
+        else if (*p == '"')
+        {
+            quoted = true;
+        }
+        else if (*p == '{' || *p == '[')
+        {
+            depth++;
+        }
+        else if (*p == '}' || *p == ']')
+        {
+            if (depth == 0)
+            {
+                return p;
+            }
+            if (--depth == 0)
+            {
+                return p + 1;
+            }
+        }
+        else if (depth == 0 && (*p == ',' || *p == ' ' || *p == '\t'))
+        {
+            return p;
+        }
+    }
+    return p;
+}
+
+/*!
+ * \brief Get members with known keys (json_keys[]) and numeric values
+ *
+ * Scans the top level of a JSON object in place. Values are converted like
+ * by ArduinoJson's as<double>() - true/false are 1/0; strings, objects,
+ * arrays and null are skipped.
+ *
+ * \param line     JSON line
+ * \param len      line length
+ * \param members  members found
+ *
+ * \returns number of members
+ */
+static size_t parseMembers(const char *line, size_t len, Member (&members)[JK_NUM])
+{
+    const char *end = line + len;
+    const char *p = skipSpace(line + 1, end);
+    size_t n = 0;
+
+    while (p < end && *p == '"')
+    {
+        const char *name = ++p;
+        while (p < end && *p != '"')
+        {
+            p += (*p == '\\') ? 2 : 1;
+        }
+        if (p >= end)
+        {
+            break;
+        }
+        int key = fieldIndex(name, p - name);
+        p = skipSpace(p + 1, end);
+        if (p >= end || *p != ':')
+        {
+            break;
+        }
+        p = skipSpace(p + 1, end);
+
+        if (key >= 0 && n < JK_NUM && p < end)
+        {
+            // Copy value - the mapping is not NUL-terminated
+            char buf[32];
+            size_t k = 0;
+            while (p + k < end && k < sizeof(buf) - 1 && !strchr(",}] \t", p[k]))
+            {
+                buf[k] = p[k];
+                k++;
+            }
+            buf[k] = '\0';
+
+            char *e;
+            double v = strtod(buf, &e);
+            if (e != buf && (*buf == '-' || (*buf >= '0' && *buf <= '9')))
+            {
+                members[n++] = {(uint8_t)key, v};
+            }
+            else if (strcmp(buf, "true") == 0 || strcmp(buf, "false") == 0)
+            {
+                members[n++] = {(uint8_t)key, (double)(*buf == 't')};
+            }
+        }
+        p = skipSpace(skipValue(p, end), end);
+        if (p >= end || *p != ',')
+        {
+            break;
+        }
+        p = skipSpace(p + 1, end);
+    }
+    return n;
+}
+
+/*!
+ * \brief Update sensor record from JSON line and encode frame
+ *
+ * Like jsonSensor() in the sketch: a changed sensor type starts with an
+ * empty record; only the keys consumed by the encoder and sensor type are
+ * applied.
+ *
+ * \param p        encoder
+ * \param sensors  sensor data records by sensor ID
+ * \param line     JSON line
+ * \param len      line length
+ * \param frame    frame (preamble, sync word and payload)
+ */
+static void encodeLine(const Protocol &p, std::unordered_map<uint32_t, SensorRecord> &sensors,
+                       const char *line, size_t len, uint8_t *frame)
+{
+    Member members[JK_NUM];
+    size_t n = parseMembers(line, len, members);
+
+    uint32_t id = 0;
+    int s_type = -1;
+    for (size_t i = 0; i < n; i++)
+    {
+        if (members[i].key == JK_SENSOR_ID && members[i].value > 0 && members[i].value < 4294967296.0)
+        {
+            id = (uint32_t)members[i].value;
+        }
+        else if (members[i].key == JK_S_TYPE && members[i].value >= 0 && members[i].value < 256)
+        {
+            s_type = (int)members[i].value;
+        }
+    }
+
+    auto it = sensors.find(id);
+    if (it == sensors.end())
+    {
+        it = sensors.emplace(id, SensorRecord()).first;
+        it->second.s_type = p.s_type;
+    }
+    SensorRecord &rec = it->second;
+    if (s_type >= 0 && s_type != rec.s_type)
+    {
+        rec = SensorRecord();
+        rec.s_type = s_type;
+    }
+
+    uint32_t keys = jsonKeys(p.encoder, rec.s_type);
+    for (size_t i = 0; i < n; i++)
+    {
+        if (keys & JK(members[i].key))
+        {
+            setField(rec, members[i].key, members[i].value);
+        }
+    }
+
+    memcpy(frame, frame_header, FRAME_HEADER_SIZE);
+    memset(&frame[FRAME_HEADER_SIZE], 0, p.size);
+    p.encode(&frame[FRAME_HEADER_SIZE], rec);
+    if (p.whitening)
+    {
+        whiten(&frame[FRAME_HEADER_SIZE], p.size, p.whitening);
+    }
+
+    // 6-in-1: temperature/humidity and rain messages alternate per sensor
+    rec.msg_type ^= bresser6In1Alternating(rec.s_type);
+}
+
+//! Open and configure serial port (raw mode)
+static int openSerial(const char *device, long baud)
+{
+    static const struct {
+        long baud;
+        speed_t speed;
+    } speeds[] = {
+        {9600, B9600}, {19200, B19200}, {38400, B38400}, {57600, B57600},
+        {115200, B115200}, {230400, B230400}, {460800, B460800}, {921600, B921600}
+    };
+
+    int fd = ::open(device, O_WRONLY | O_NOCTTY);
+    if (fd < 0)
+    {
+        perror(device);
+        return -1;
+    }
+    speed_t speed = 0;
+    for (const auto &s : speeds)
+    {
+        if (s.baud == baud)
+        {
+            speed = s.speed;
+        }
+    }
+    if (!speed)
+    {
+        fprintf(stderr, "Unsupported baud rate %ld\n", baud);
+        close(fd);
+        return -1;
+    }
+    struct termios tio;
+    if (tcgetattr(fd, &tio) == 0)
+    {
+        cfmakeraw(&tio);
+        cfsetispeed(&tio, speed);
+        cfsetospeed(&tio, speed);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+//! Write line and line terminator directly from the mapping
+static bool writeLine(int fd, const char *line, size_t len)
+{
+    static char nl = '\n';
+    struct iovec iov[2] = {{(void *)line, len}, {&nl, 1}};
+    int iovcnt = 2;
+    struct iovec *v = iov;
+
+    while (iovcnt > 0)
+    {
+        ssize_t n = writev(fd, v, iovcnt);
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            perror("write");
+            return false;
+        }
+        // Partial write - skip the bytes already written
+        while (iovcnt > 0 && (size_t)n >= v->iov_len)
+        {
+            n -= v->iov_len;
+            v++;
+            iovcnt--;
+        }
+        if (iovcnt > 0)
+        {
+            v->iov_base = (char *)v->iov_base + n;
+            v->iov_len -= n;
+        }
+    }
+    return true;
+}
+
+static int64_t nowUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void sleepUntilUs(int64_t t)
+{
+    struct timespec ts;
+    ts.tv_sec = t / 1000000;
+    ts.tv_nsec = (t % 1000000) * 1000;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+    {
+    }
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Usage: %s [-s <speed>] [-d <device>] [-b <baud>] [-m <max_len>] [-n] <logfile>\n"
+                    "       %s [-s <speed>] [-x <encoder>] [-m <max_len>] [-n] <logfile> > <frame_file>\n",
+            name, name);
+}
+
+int main(int argc, char *argv[])
+{
+    double speed = 1.0;
+    const char *device = nullptr;
+    long baud = 115200;
+    size_t max_len = 2048;
+    bool pacing = true;
+    const Protocol *proto = nullptr;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "s:d:b:m:nx:")) != -1)
+    {
+        switch (opt)
+        {
+        case 's':
+            speed = atof(optarg);
+            break;
+        case 'd':
+            device = optarg;
+            break;
+        case 'b':
+            baud = atol(optarg);
+            break;
+        case 'm':
+            max_len = atol(optarg);
+            break;
+        case 'n':
+            pacing = false;
+            break;
+        case 'x':
+            for (const Protocol &p : protocols)
+            {
+                if (strcmp(optarg, p.name) == 0)
+                {
+                    proto = &p;
+                }
+            }
+            if (!proto)
+            {
+                fprintf(stderr, "Unknown encoder '%s'!\n", optarg);
+                return 1;
+            }
+            break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (optind >= argc || speed < 1.0 || speed > 1000.0 || (proto && device))
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    LineSource src;
+    if (!src.open(argv[optind]))
+    {
+        return 1;
+    }
+    int fd = device ? openSerial(device, baud) : STDOUT_FILENO;
+    if (fd < 0)
+    {
+        return 1;
+    }
+
+    uint64_t frames = 0;
+    uint64_t skipped = 0;
+    uint64_t bytes = 0;
+    int64_t max_late = 0;
+    bool have_t0 = false;
+    int64_t t0 = 0;
+    int64_t ts = 0;
+    std::unordered_map<uint32_t, SensorRecord> sensors;
+    int64_t start = nowUs();
+
+    const char *line;
+    size_t len;
+    while (src.next(line, len))
+    {
+        if (len == 0 || line[0] != '{')
+        {
+            continue;
+        }
+        if (len > max_len)
+        {
+            skipped++;
+            continue;
+        }
+
+        int64_t t;
+        if (parseTime(line, len, t))
+        {
+            if (!have_t0)
+            {
+                t0 = t;
+                have_t0 = true;
+            }
+            // Timestamps going backwards (e.g. concatenated logs) are sent immediately
+            if (t - t0 > ts)
+            {
+                ts = t - t0;
+            }
+        }
+
+        if (pacing)
+        {
+            int64_t due = start + (int64_t)(ts / speed);
+            int64_t now = nowUs();
+            if (now < due)
+            {
+                sleepUntilUs(due);
+            }
+            else if (now - due > max_late)
+            {
+                max_late = now - due;
+            }
+        }
+
+        if (proto)
+        {
+            static const char hex[] = "0123456789ABCDEF";
+            uint8_t frame[FRAME_HEADER_SIZE + 26];
+            char text[32 + 2 * sizeof(frame)];
+
+            encodeLine(*proto, sensors, line, len, frame);
+            size_t n = FRAME_HEADER_SIZE + proto->size;
+            int k = snprintf(text, sizeof(text), "%lld.%06lld ", (long long)(ts / 1000000), (long long)(ts % 1000000));
+            for (size_t i = 0; i < n; i++)
+            {
+                text[k++] = hex[frame[i] >> 4];
+                text[k++] = hex[frame[i] & 0xF];
+            }
+            text[k++] = '\n';
+            fwrite(text, 1, k, stdout);
+            if (pacing)
+            {
+                fflush(stdout);
+            }
+            bytes += n;
+        }
+        else
+        {
+            if (!writeLine(fd, line, len))
+            {
+                return 1;
+            }
+            bytes += len + 1;
+        }
+        frames++;
+    }
+    if (proto && fflush(stdout) != 0)
+    {
+        perror("write");
+        return 1;
+    }
+    if (device)
+    {
+        tcdrain(fd);
+        close(fd);
+    }
+
+    double elapsed = (nowUs() - start) / 1e6;
+    fprintf(stderr, "Frames: %llu, skipped: %llu, bytes: %llu, time: %.3f s, %.1f frames/s, max. lateness: %.3f ms\n",
+            (unsigned long long)frames, (unsigned long long)skipped, (unsigned long long)bytes,
+            elapsed, elapsed > 0 ? frames / elapsed : 0.0, max_late / 1000.0);
+    return 0;
+}
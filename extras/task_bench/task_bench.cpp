@@ -0,0 +1,319 @@
+///////////////////////////////////////////////////////////////////////////////
+// task_bench.cpp
+//
+// Host benchmark - RAM per task and context switch overhead of the
+// cooperative tasks (Tasks.h) compared with C++20 coroutines
+//
+// - round robin: <tasks> tasks which only yield, i.e. each call of the
+//   scheduler resumes and suspends each task once
+// - ping-pong: two tasks which hand over an event to each other, i.e. one
+//   task switch per handover plus the calls of the waiting task
+//
+// The coroutine variant is only built with C++20 (-std=c++20); its frames
+// are allocated from the heap, the frame size is reported by operator new
+// of the promise type.
+//
+// Build (Linux):
+//   g++ -std=c++20 -O2 -Wall -I../.. -o task_bench task_bench.cpp
+//   (in extras/task_bench)
+//
+// Usage:
+//   task_bench [-t <tasks>] [-n <passes>]
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//          Time measurement from ../common/BenchHarness.h
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "Tasks.h"
+#include "../common/BenchHarness.h"
+
+#if defined(__cpp_impl_coroutine)
+#include <coroutine>
+#endif
+
+//! Compiler barrier - keeps the counters in memory
+#define CLOBBER() __asm__ __volatile__("" ::: "memory")
+
+static uint64_t counter;
+
+//
+// Protothreads (Tasks.h)
+//
+
+//! Task which only yields
+class YieldTask : public Task {
+public:
+    void run(uint32_t /* now */) override
+    {
+        TASK_BEGIN();
+        for (;;)
+        {
+            counter++;
+            CLOBBER();
+            TASK_YIELD();
+        }
+        TASK_END();
+    }
+};
+
+//! Task which waits for an event and then sets the other task's event
+class PingTask : public Task {
+public:
+    PingTask(Event &rx, Event &tx) : _rx(rx), _tx(tx)
+    {
+    }
+
+    void run(uint32_t /* now */) override
+    {
+        TASK_BEGIN();
+        for (;;)
+        {
+            TASK_WAIT_UNTIL(_rx.take());
+            counter++;
+            _tx.set();
+        }
+        TASK_END();
+    }
+
+private:
+    Event &_rx;
+    Event &_tx;
+};
+
+static double ptRoundRobin(unsigned tasks, uint64_t passes)
+{
+    std::vector<YieldTask> task(tasks);
+    Scheduler<1024> scheduler;
+    for (YieldTask &t : task)
+    {
+        scheduler.add(&t);
+    }
+    return measureNs(passes * tasks, 1, [&]() {
+        for (uint64_t i = 0; i < passes; i++)
+        {
+            scheduler.run(i);
+        }
+    });
+}
+
+static double ptPingPong(uint64_t passes)
+{
+    Event a, b;
+    PingTask ping(a, b);
+    PingTask pong(b, a);
+    Scheduler<2> scheduler;
+    scheduler.add(&ping);
+    scheduler.add(&pong);
+    a.set();
+    uint64_t start = counter;
+    double t = measureNs(passes, 1, [&]() {
+        for (uint64_t i = 0; i < passes; i++)
+        {
+            scheduler.run(i);
+        }
+    });
+    return t * passes / (counter - start);
+}
+
+//
+// C++20 coroutines
+//
+#if defined(__cpp_impl_coroutine)
+
+static size_t frame_size; //!< size of the last coroutine frame allocated
+
+//! Coroutine task - started suspended, resumed by the scheduler
+struct CoTask {
+    struct promise_type {
+        CoTask get_return_object()
+        {
+            return CoTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+        std::suspend_always final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void()
+        {
+        }
+        void unhandled_exception()
+        {
+            abort();
+        }
+        static void *operator new(size_t size)
+        {
+            frame_size = size;
+            return ::operator new(size);
+        }
+        static void operator delete(void *p)
+        {
+            ::operator delete(p);
+        }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+static CoTask coYield(void)
+{
+    for (;;)
+    {
+        counter++;
+        CLOBBER();
+        co_await std::suspend_always{};
+    }
+}
+
+static CoTask coPing(Event &rx, Event &tx)
+{
+    for (;;)
+    {
+        while (!rx.take())
+        {
+            co_await std::suspend_always{};
+        }
+        counter++;
+        tx.set();
+    }
+}
+
+static double coRoundRobin(unsigned tasks, uint64_t passes)
+{
+    std::vector<std::coroutine_handle<>> task;
+    for (unsigned i = 0; i < tasks; i++)
+    {
+        task.push_back(coYield().handle);
+    }
+    double t = measureNs(passes * tasks, 1, [&]() {
+        for (uint64_t i = 0; i < passes; i++)
+        {
+            for (std::coroutine_handle<> h : task)
+            {
+                h.resume();
+            }
+        }
+    });
+    for (std::coroutine_handle<> h : task)
+    {
+        h.destroy();
+    }
+    return t;
+}
+
+static double coPingPong(uint64_t passes)
+{
+    Event a, b;
+    std::coroutine_handle<> ping = coPing(a, b).handle;
+    std::coroutine_handle<> pong = coPing(b, a).handle;
+    a.set();
+    uint64_t start = counter;
+    double t = measureNs(passes, 1, [&]() {
+        for (uint64_t i = 0; i < passes; i++)
+        {
+            ping.resume();
+            pong.resume();
+        }
+    });
+    ping.destroy();
+    pong.destroy();
+    return t * passes / (counter - start);
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+    unsigned tasks = 35; // sketch: input, MAX_FLEET_SIZE sensors, encoder, radio
+    uint64_t passes = 2000000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_arg = (i + 1 < argc);
+        if (strcmp(argv[i], "-t") == 0 && has_arg)
+        {
+            tasks = atoi(argv[++i]);
+            tasks = (tasks < 1) ? 1 : (tasks > 1024) ? 1024 : tasks;
+        }
+        else if (strcmp(argv[i], "-n") == 0 && has_arg)
+        {
+            passes = strtoull(argv[++i], nullptr, 0);
+            passes = passes ? passes : 1;
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [-t <tasks>] [-n <passes>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("RAM per task [bytes]:\n");
+    printf("  %-28s %zu (vtable pointer, resume point, padding)\n", "protothread (Task)", sizeof(YieldTask));
+    printf("  %-28s %zu\n", "  + event reference (x2)", sizeof(PingTask));
+#if defined(__cpp_impl_coroutine)
+    CoTask co = coYield();
+    size_t yield_frame = frame_size;
+    co.handle.destroy();
+    Event a, b;
+    co = coPing(a, b);
+    size_t ping_frame = frame_size;
+    co.handle.destroy();
+    printf("  %-28s %zu (heap) + %zu (handle)\n", "coroutine (round robin)", yield_frame,
+           sizeof(std::coroutine_handle<>));
+    printf("  %-28s %zu (heap) + %zu (handle)\n", "coroutine (ping-pong)", ping_frame,
+           sizeof(std::coroutine_handle<>));
+#else
+    printf("  coroutines: not available (build with -std=c++20)\n");
+#endif
+
+    printf("\nSwitch overhead [ns] (%u tasks, %llu passes):\n", tasks, (unsigned long long)passes);
+    printf("  %-28s %8.2f per task resume\n", "protothread round robin", ptRoundRobin(tasks, passes));
+    printf("  %-28s %8.2f per event handover\n", "protothread ping-pong", ptPingPong(passes));
+#if defined(__cpp_impl_coroutine)
+    printf("  %-28s %8.2f per task resume\n", "coroutine round robin", coRoundRobin(tasks, passes));
+    printf("  %-28s %8.2f per event handover\n", "coroutine ping-pong", coPingPong(passes));
+#endif
+    return 0;
+}
@@ -0,0 +1,174 @@
+///////////////////////////////////////////////////////////////////////////////
+// weather_bench.cpp
+//
+// Host benchmark - synthetic weather time series (WeatherGen.h)
+//
+// <sensors> generators per sensor type are advanced by <steps> updates of
+// one simulated minute each (as with DATA_GEN and a transmit interval of
+// 60 s); the time per update() is measured. Before the measurement, the
+// time series are checked: rain gauge not decreasing, values in range.
+//
+// Build (Linux):
+//   g++ -std=c++17 -O2 -Wall -I../.. -o weather_bench weather_bench.cpp
+//   (in extras/weather_bench)
+//
+// Usage:
+//   weather_bench [<sensors> [<steps>]]
+//
+//
+// https://github.com/matthias-bs/SensorTransmitter
+//
+// created: 10/2026
+//
+//
+// MIT License
+//
+// Copyright (c) 2026 Matthias Prinke
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+// History:
+//
+// 20261016 Created
+//
+// ToDo:
+// -
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+
+#include "WeatherGen.h"
+#include "../common/BenchHarness.h"
+
+#define SEED        1           //!< common seed of the generators
+#define START_S     (8 * 3600)  //!< simulated time of day at start
+#define STEP_MS     60000       //!< time between updates in ms
+
+//! Sensor type
+struct SensorType {
+    const char *name;
+    uint8_t s_type;
+};
+
+static const SensorType sensor_types[] = {
+    {"weather", SENSOR_TYPE_WEATHER1},
+    {"soil", SENSOR_TYPE_SOIL},
+    {"air-pm", SENSOR_TYPE_AIR_PM},
+    {"co2", SENSOR_TYPE_CO2},
+    {"hcho-voc", SENSOR_TYPE_HCHO_VOC},
+    {"lightning", SENSOR_TYPE_LIGHTNING},
+    {"leakage", SENSOR_TYPE_LEAKAGE}
+};
+
+//! Check time series of one sensor over the given number of steps
+static bool check(const SensorType &type, uint16_t index, size_t steps)
+{
+    WeatherGen gen;
+    SensorRecord rec = {};
+    rec.s_type = type.s_type;
+    gen.begin(SEED, index, START_S, 1);
+
+    uint32_t rain = 0;
+    for (size_t i = 0; i < steps; i++)
+    {
+        gen.update(rec, i * STEP_MS);
+        bool ok = true;
+        switch (type.s_type)
+        {
+        case SENSOR_TYPE_SOIL:
+            ok = rec.soil.moisture <= 100;
+            break;
+        case SENSOR_TYPE_HCHO_VOC:
+            ok = rec.voc.voc_level >= 1 && rec.voc.voc_level <= 5;
+            break;
+        case SENSOR_TYPE_LIGHTNING:
+            ok = rec.lgt.strike_count < 1600 && rec.lgt.distance_km >= 1 && rec.lgt.distance_km <= 40;
+            break;
+        case SENSOR_TYPE_WEATHER1:
+            ok = rec.w.rain_mm10 >= rain && rec.w.humidity >= 15 && rec.w.humidity <= 99 &&
+                 rec.w.wind_dir_deg10 < 3600 && rec.w.wind_gust_ms10 >= rec.w.wind_avg_ms10;
+            rain = rec.w.rain_mm10;
+            break;
+        default:
+            break;
+        }
+        if (!ok)
+        {
+            fprintf(stderr, "%s: sensor %u, step %zu: value out of range!\n", type.name, index, i);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t sensors = (argc > 1) ? atol(argv[1]) : 1000;
+    size_t steps = (argc > 2) ? atol(argv[2]) : 1000;
+    if (sensors < 1 || sensors > 65535 || steps < 1)
+    {
+        fprintf(stderr, "Usage: %s [<sensors> [<steps>]] (sensors: 1...65535)\n", argv[0]);
+        return 1;
+    }
+
+    printf("%zu sensors per type, %zu updates of %u s\n\n", sensors, steps, STEP_MS / 1000);
+    printf("%-12s %12s\n", "Sensor type", "update [ns]");
+
+    uint32_t sink = 0;
+    for (const SensorType &type : sensor_types)
+    {
+        for (uint16_t k = 0; k < std::min(sensors, (size_t)16); k++)
+        {
+            if (!check(type, k, steps))
+            {
+                return 1;
+            }
+        }
+
+        std::vector<WeatherGen> gen(sensors);
+        std::vector<SensorRecord> rec(sensors, SensorRecord());
+        for (size_t k = 0; k < sensors; k++)
+        {
+            gen[k].begin(SEED, k, START_S, 1);
+            rec[k].s_type = type.s_type;
+        }
+        uint32_t now_ms = 0;
+        double t = measureNs(sensors, steps, [&]() {
+            for (size_t k = 0; k < sensors; k++)
+            {
+                gen[k].update(rec[k], now_ms);
+            }
+            now_ms += STEP_MS;
+        });
+        for (const SensorRecord &r : rec)
+        {
+            sink += r.w.temp_c10 + r.soil.moisture + r.pm.pm_2_5 + r.co2.co2_ppm + r.voc.hcho_ppb +
+                    r.lgt.strike_count + r.leak.alarm;
+        }
+        printf("%-12s %12.1f\n", type.name, t);
+    }
+    printf("\n(checksum %08X)\n", sink);
+    return 0;
+}